@@ -47,6 +47,11 @@ namespace lsp
 
             static constexpr size_t         FFT_RANK            = 13;
             static constexpr size_t         FFT_ITEMS           = 1 << FFT_RANK;
+            static constexpr size_t         FFT_RANK_MIN        = 11;
+            static constexpr size_t         FFT_RANK_MAX        = 14;
+            static constexpr size_t         FFT_RES_DFL         = 0;
+            static constexpr size_t         RESAMPLER_DFL       = 3;
+            static constexpr size_t         RESAMPLER_QUALITIES = 5;
             static constexpr size_t         MESH_POINTS         = 640;
             static constexpr size_t         FFT_WINDOW          = lsp::dspu::windows::HANN;
             static constexpr size_t         FFT_ENVELOPE        = lsp::dspu::envelope::PINK_NOISE;
@@ -56,6 +61,21 @@ namespace lsp
             static constexpr float          REACT_TIME_DFL      = 0.200;
             static constexpr float          REACT_TIME_STEP     = 0.001;
 
+            static constexpr float          SMOOTH_TIME_MIN     = 0.0f;
+            static constexpr float          SMOOTH_TIME_MAX     = 200.0f;
+            static constexpr float          SMOOTH_TIME_DFL     = 10.0f;
+            static constexpr float          SMOOTH_TIME_STEP    = 0.01f;
+
+            static constexpr float          DSP_LOAD_MIN        = 0.0f;
+            static constexpr float          DSP_LOAD_MAX        = 100.0f;
+            static constexpr float          DSP_LOAD_DFL        = 0.0f;
+            static constexpr float          DSP_LOAD_STEP       = 0.01f;
+
+            static constexpr float          LATENCY_MIN         = 0.0f;
+            static constexpr float          LATENCY_MAX         = 1000.0f;
+            static constexpr float          LATENCY_DFL         = 0.0f;
+            static constexpr float          LATENCY_STEP        = 0.01f;
+
             static constexpr float          ZOOM_MIN            = GAIN_AMP_M_42_DB;
             static constexpr float          ZOOM_MAX            = GAIN_AMP_0_DB;
             static constexpr float          ZOOM_DFL            = GAIN_AMP_M_36_DB;
@@ -66,6 +86,9 @@ namespace lsp
             static constexpr size_t         MODE_DFL            = 0;
 
             static constexpr size_t         REFRESH_RATE        = 20;
+            static constexpr size_t         FILTERS_X4          = 4;
+            static constexpr size_t         CHANNELS_X8         = 8;
+            static constexpr size_t         CHANNELS_X16        = 16;
 
             enum eq_filter_t
             {
@@ -98,12 +121,20 @@ namespace lsp
                 PEM_IIR,
                 PEM_FIR,
                 PEM_FFT,
-                PEM_SPM
+                PEM_SPM,
+                PEM_HLP,
+                PEM_HMP
             };
         };
 
         extern const meta::plugin_t filter_mono;
         extern const meta::plugin_t filter_stereo;
+        extern const meta::plugin_t filter_x4_mono;
+        extern const meta::plugin_t filter_x4_stereo;
+        extern const meta::plugin_t filter_lr;
+        extern const meta::plugin_t filter_ms;
+        extern const meta::plugin_t filter_x8_multi;
+        extern const meta::plugin_t filter_x16_multi;
 
     } // namespace meta
 } // namespace lsp
@@ -22,13 +22,16 @@
 #ifndef PRIVATE_PLUGINS_FILTER_H_
 #define PRIVATE_PLUGINS_FILTER_H_
 
+#include <lsp-plug.in/common/atomic.h>
 #include <lsp-plug.in/plug-fw/plug.h>
 #include <lsp-plug.in/plug-fw/core/IDBuffer.h>
 #include <lsp-plug.in/dsp-units/ctl/Bypass.h>
 #include <lsp-plug.in/dsp-units/filters/Equalizer.h>
 #include <lsp-plug.in/dsp-units/util/Analyzer.h>
+#include <lsp-plug.in/dsp-units/util/Convolver.h>
 #include <lsp-plug.in/dsp-units/util/Delay.h>
 #include <lsp-plug.in/dsp-units/util/Oversampler.h>
+#include <lsp-plug.in/ipc/ITask.h>
 
 #include <private/meta/filter.h>
 
@@ -45,7 +48,10 @@ namespace lsp
                 enum eq_mode_t
                 {
                     EQ_MONO,
-                    EQ_STEREO
+                    EQ_STEREO,
+                    EQ_LEFT_RIGHT,
+                    EQ_MID_SIDE,
+                    EQ_MULTI
                 };
 
             protected:
@@ -55,6 +61,13 @@ namespace lsp
                     CS_SYNC_AMP     = 1 << 1
                 };
 
+                enum idisplay_state_t
+                {
+                    IDS_UNKNOWN,                        // The presence of the inline display should be detected
+                    IDS_HIDDEN,                         // The host does not render the inline display
+                    IDS_SHOWN                           // The host renders the inline display
+                };
+
                 enum fft_position_t
                 {
                     FFTP_NONE,
@@ -62,40 +75,202 @@ namespace lsp
                     FFTP_PRE
                 };
 
-                typedef struct eq_channel_t
+                enum kernel_mode_t
                 {
-                    dspu::Oversampler   sOversampler;   // Oversampler
-                    dspu::Equalizer     sEqualizer;     // Equalizer
-                    dspu::Bypass        sBypass;        // Bypass
-                    dspu::Delay         sDryDelay;      // Dry delay
+                    KM_NONE,                            // The signal is processed by the equalizer
+                    KM_LINEAR,                          // Linear-phase kernel processed by the partitioned convolver
+                    KM_MINIMUM                          // Minimum-phase kernel processed by the partitioned convolver
+                };
+
+                enum design_state_t
+                {
+                    DS_NONE,                            // The active equalizer is up to date
+                    DS_PENDING,                         // Filter parameters have changed, the design should be submitted
+                    DS_DESIGN,                          // The design task builds the kernel of the next equalizer
+                    DS_WARMUP,                          // The next equalizer is being filled with the input signal
+                    DS_XFADE                            // Crossfade from the active equalizer to the next one
+                };
+
+                enum identity_state_t
+                {
+                    IS_OFF,                             // The signal is processed by the filters
+                    IS_ON,                              // The filters are transparent, the delayed input is passed
+                    IS_WARMUP,                          // The filters are being filled with the input signal
+                    IS_XFADE                            // Crossfade from the delayed input to the filtered signal
+                };
+
+                enum profile_stage_t
+                {
+                    PS_DRY_DELAY,
+                    PS_INPUT,
+                    PS_OVERSAMPLER,
+                    PS_EQUALIZER,
+                    PS_ANALYZER,
+                    PS_OUTPUT,
+
+                    PS_TOTAL
+                };
+
+                enum latency_stage_t
+                {
+                    LS_OVERSAMPLER,
+                    LS_EQUALIZER,
+
+                    LS_TOTAL
+                };
+
+                class AnalysisTask: public ipc::ITask
+                {
+                    private:
+                        filter             *pCore;
+
+                    public:
+                        explicit AnalysisTask(filter *core);
+                        virtual ~AnalysisTask() override;
+
+                    public:
+                        virtual status_t    run() override;
+                };
+
+                class DesignTask: public ipc::ITask
+                {
+                    private:
+                        filter             *pCore;
+
+                    public:
+                        explicit DesignTask(filter *core);
+                        virtual ~DesignTask() override;
+
+                    public:
+                        virtual status_t    run() override;
+                };
+
+                typedef struct analysis_t
+                {
+                    float              *vRing[4];       // Ring buffers with samples for analysis
+                    float              *vSpectrum[4];   // Spectrum data published by the analysis task
+                    uint32_t            nHead;          // Write position of the ring, owned by the audio thread
+                    uint32_t            nTail;          // Read position of the ring
+                    uint32_t            nCount;         // Number of samples passed to the analysis task
+                    uint32_t            nDelay;         // Delay of the input signal
+                    uint32_t            nRank;          // Selected FFT rank
+                    uint32_t            nMaxRank;       // FFT rank the analyzer buffers are allocated for
+                    uint32_t            nChannels;      // Number of analyzed channels
+                    uint32_t            nSource;        // Index of the first analyzed channel
+                    float               fReactivity;    // Reactivity
+                    float               fShift;         // Shift gain
+                    bool                vEnable[4];     // Enabled analyzer channels
+                    bool                bActive;        // Analysis is active
+                    bool                bSync;          // Settings of the analyzer should be updated
+                    bool                bRealloc;       // The analysis task should re-allocate the analyzer
+                } analysis_t;
+
+                typedef struct filter_ramp_t
+                {
+                    dspu::filter_params_t sCurr;        // Currently applied filter parameters
+                    float               fFreqK;         // Frequency multiplier per design step
+                    float               fFreq2K;        // Second frequency multiplier per design step
+                    float               fGainK;         // Gain multiplier per design step
+                    float               fQualityD;      // Quality factor increment per design step
+                    uint32_t            nSteps;         // Number of design steps left
+                    uint32_t            nStepSize;      // Size of the design step in samples
+                    uint32_t            nOffset;        // Number of samples left in the current design step
+                } filter_ramp_t;
 
+                typedef struct eq_filter_t
+                {
                     dspu::filter_params_t sOldFP;       // Old filter parameters
                     dspu::filter_params_t sFP;          // Filter parameters
+                    dspu::filter_params_t sDesignFP;    // Filter parameters passed to the design task
+                    filter_ramp_t       sRamp;          // Parameter smoothing ramp
+
+                    plug::IPort        *pEnable;        // Filter enable
+                    plug::IPort        *pType;          // Filter type
+                    plug::IPort        *pMode;          // Filter mode
+                    plug::IPort        *pFreq;          // Filter frequency
+                    plug::IPort        *pWidth;         // Filter width
+                    plug::IPort        *pSlope;         // Filter slope
+                    plug::IPort        *pGain;          // Filter gain
+                    plug::IPort        *pQuality;       // Quality factor
+                } eq_filter_t;
+
+                typedef struct design_request_t
+                {
+                    uint32_t            nRank;          // Rank of the kernel
+                    uint32_t            nMode;          // Equalizer mode
+                    uint32_t            nKernel;        // Kernel mode of hybrid equalization
+                    uint32_t            nDecramp;       // Decramping of the equalizer
+                    uint32_t            nQuality;       // Quality of the decramping resampler
+                    float               fSampleRate;    // Sample rate of the kernel
+                    float               fEqRate;        // Sample rate of the equalizer
+                } design_request_t;
+
+                typedef struct kernel_buf_t
+                {
+                    float              *vKernel;        // Designed kernel
+                    float              *vRe;            // Real part of the kernel spectrum
+                    float              *vIm;            // Imaginary part of the kernel spectrum
+                    float              *vFreq;          // Frequencies of the kernel spectrum bins
+                    float              *vTr;            // Transfer function at the kernel spectrum bins
+                    uint32_t            nRank;          // Rank of the longest kernel the buffers are allocated for
+                    uint8_t            *pData;          // Allocated data
+                } kernel_buf_t;
 
+                typedef struct eq_channel_t
+                {
+                    dspu::Oversampler   vOversampler[2];// Active and next oversamplers
+                    dspu::Oversampler  *pOversampler;   // Active oversampler
+                    dspu::Oversampler  *pOvsNext;       // Oversampler of the next equalizer when the decramping changes
+                    dspu::Equalizer     vEqualizer[2];  // Active and next equalizers with all filter slots
+                    dspu::Equalizer    *pEqualizer;     // Active equalizer
+                    dspu::Equalizer    *pDesign;        // Next equalizer designed in background for non-IIR modes
+                    dspu::Convolver     vConvolver[2];  // Active and next convolvers for hybrid modes
+                    dspu::Convolver    *pConvolver;     // Active convolver
+                    dspu::Convolver    *pConvNext;      // Next convolver with the kernel designed in background
+                    dspu::Delay         vAlign[2];      // Delays aligning the active and next equalizers to the reported latency
+                    dspu::Delay        *pAlign;         // Alignment delay of the active equalizer
+                    dspu::Delay        *pAlignNext;     // Alignment delay of the next equalizer
+                    dspu::Bypass        sBypass;        // Bypass
+                    dspu::Delay         sDryDelay;      // Dry delay
+
+                    eq_filter_t        *vFilters;       // Filter slots
                     uint32_t            nLatency;       // Latency of the channel
-                    float               fInGain;        // Input gain
+                    uint32_t            nPad;           // Alignment delay of the active equalizer
+                    uint32_t            nDesignPad;     // Alignment delay of the next equalizer
+                    uint32_t            nDesignLatency; // Latency of the channel after the next equalizer becomes active
                     float               fOutGain;       // Output gain
                     float              *vDryBuf;        // Dry buffer
                     float              *vInBuffer;      // Input buffer (input signal passed to analyzer)
                     float              *vOutBuffer;     // Output buffer
+                    float              *vOvsBuffer;     // Oversampled data buffer
+                    float              *vXfBuffer;      // Output of the next equalizer
+                    float              *vPreroll;       // Ring buffer of recent input samples to warm up the filters after bypass
                     float              *vIn;            // Input buffer
                     float              *vOut;           // Output buffer
                     float              *vInPtr;         // Actual pointer to input data (for eliminatioon of unnecessary memory copies)
                     float              *vTr;            // Transfer function (real part)
                     float              *vTrMem;         // Transfer function (stored output)
                     uint32_t            nSync;          // Chart state
-
-                    plug::IPort        *pType;          // Filter type
-                    plug::IPort        *pMode;          // Filter mode
-                    plug::IPort        *pFreq;          // Filter frequency
-                    plug::IPort        *pWidth;         // Filter width
-                    plug::IPort        *pSlope;         // Filter slope
-                    plug::IPort        *pGain;          // Filter gain
-                    plug::IPort        *pQuality;       // Quality factor
+                    uint32_t            nDesign;        // Design state of the next equalizer
+                    uint32_t            nXfOffset;      // Number of samples processed in the current design state
+                    uint32_t            nXfLength;      // Length of the current design state in samples
+                    uint32_t            nRank;          // Rank of the active equalizer and convolver kernels
+                    uint32_t            nDesignRank;    // Rank of the next equalizer and convolver kernels
+                    uint32_t            nDecramp;       // Decramping of the active equalizer
+                    uint32_t            nDesignDecramp; // Decramping of the next equalizer
+                    uint32_t            nKernel;        // Kernel mode of the active convolver, KM_NONE if the equalizer is active
+                    uint32_t            nDesignKernel;  // Kernel mode of the next convolver
+                    bool                bDesign;        // The next equalizer is owned by the design task
+                    bool                bRedesign;      // Filter parameters have changed while the design was in progress
+                    bool                bOvsNext;       // The second oversampler is allocated
+                    bool                bAlign;         // The alignment delays are allocated
+                    uint32_t            nIdentity;      // Identity state of the group of linked channels
+                    uint32_t            nIdOffset;      // Number of samples processed in the current identity state
+                    uint32_t            nIdLength;      // Length of the current identity state in samples
+                    bool                bIdentity;      // All filters of the channel are transparent
 
                     plug::IPort        *pIn;            // Input port
                     plug::IPort        *pOut;           // Output port
-                    plug::IPort        *pInGain;        // Input gain
                     plug::IPort        *pTrAmp;         // Amplitude chart
                     plug::IPort        *pFftInSwitch;   // FFT input switch
                     plug::IPort        *pFftOutSwitch;  // FFT output switch
@@ -107,47 +282,145 @@ namespace lsp
 
             protected:
                 dspu::Analyzer      sAnalyzer;              // Analyzer
+                analysis_t          sAnalysis;              // Analysis data exchange with the background task
+                AnalysisTask        sAnalysisTask;          // Background analysis task
+                DesignTask          sDesignTask;            // Background kernel design task
                 uint32_t            nMode;                  // Operating mode
+                uint32_t            nChannels;              // Number of channels
+                uint32_t            nLinks;                 // Number of channels sharing the same filter design
+                uint32_t            nFilters;               // Number of filter slots
                 uint32_t            nDecramp;               // Decamping
+                uint32_t            nKernel;                // Kernel mode of hybrid equalization
+                uint32_t            nResampler;             // Quality of the decramping resampler
+                uint32_t            nTailLength;            // Number of silent input samples after which the output decays
+                uint32_t            nIdle;                  // Number of silent input samples processed
+                uint32_t            nPrerollHead;           // Write position in the pre-roll history
+                uint32_t            nIDisplay;              // State of the inline display
+                uint32_t            nIDisplayQuery;         // Number of samples processed since the unanswered redraw request
+                uatomic_t           nIDisplayDraws;         // Number of inline display draws, incremented by the UI thread
+                uatomic_t           nIDisplaySeen;          // Number of inline display draws seen by the audio thread
+                uint32_t            nKernelRank;            // Rank of kernels selected for the filter settings
+                design_request_t    sDesign;                // Settings of the kernels passed to the design task
+                uint32_t            nLatency;               // Latency reported to the host
+                uint32_t            nMaxLatency;            // Maximum latency of channels
+                uint32_t            vResampleLatency[meta::filter_metadata::RESAMPLER_QUALITIES]; // Longest latency of the decramping resampler of each quality
+                uint32_t            vStageLatency[LS_TOTAL];// Latency of each processing stage, samples
                 eq_channel_t       *vChannels;              // List of channels
                 float              *vFreqs;                 // Frequency list
                 float              *vBuffer;                // Temporary buffer
+                kernel_buf_t        sKernel;                // Kernel buffers allocated when the hybrid mode is selected
                 uint32_t           *vIndexes;               // FFT indexes
                 float               fGainIn;                // Input gain
                 float               fZoom;                  // Zoom gain
-                bool                bSmoothMode;            // Smooth mode for the equalizer
+                float               fSmoothTime;            // Parameter smoothing time
+                bool                bProfile;               // DSP load profiling is enabled
+                bool                bMeters;                // Signal level metering is enabled
+                bool                bUIActive;              // The UI is currently shown
+                bool                bIDisplayQuery;         // The redraw of the inline display has been requested
+                bool                bIDisplayDirty;         // The inline display should be redrawn
+                bool                bVisual;                // Visual data (analysis, meshes) should be computed
+                bool                bBypassed;              // Only the dry signal is passed to the output
+                bool                bAutoDecramp;           // Decramping is selected automatically
+                bool                bIdle;                  // The output has faded out after the tail has decayed
+                uint64_t            vStageTime[PS_TOTAL];   // Time spent by each processing stage, nanoseconds
+                float               vStageLoad[PS_TOTAL];   // DSP load of each processing stage, percents
                 core::IDBuffer     *pIDisplay;              // Inline display buffer
 
                 plug::IPort        *pBypass;                // Bypass port
                 plug::IPort        *pGainIn;                // Input gain port
                 plug::IPort        *pGainOut;               // Output gain port
                 plug::IPort        *pReactivity;            // FFT reactivity
+                plug::IPort        *pFftRes;                // FFT resolution
+                plug::IPort        *pFftChannel;            // Analyzed channel
                 plug::IPort        *pShiftGain;             // Shift gain
                 plug::IPort        *pZoom;                  // Graph zoom
                 plug::IPort        *pEqMode;                // Equalizer mode
                 plug::IPort        *pEqDecramp;             // Equalizer decramping
+                plug::IPort        *pResampler;             // Decramping resampler quality
+                plug::IPort        *pSmooth;                // Parameter smoothing time
                 plug::IPort        *pBalance;               // Output balance
+                plug::IPort        *pMeters;                // Signal level metering switch
+                plug::IPort        *pLatency;               // Latency meter
+                plug::IPort        *pStageLatency[LS_TOTAL];// Latency meters of processing stages
+                plug::IPort        *pProfile;               // DSP load profiling switch
+                plug::IPort        *pStageLoad[PS_TOTAL];   // DSP load meters of processing stages
 
             protected:
                 static inline dspu::equalizer_mode_t get_eq_mode(ssize_t mode);
+                static inline uint32_t  get_kernel_mode(ssize_t mode);
                 static inline void  decode_filter(uint32_t *ftype, uint32_t *slope, size_t mode);
                 static size_t       decode_slope(size_t slope);
                 static bool         filter_has_width(size_t type);
                 static inline bool  adjust_gain(size_t filter_type);
+                static inline bool  is_identity(const dspu::filter_params_t *fp);
                 static float        calc_qfactor(float q, size_t type, size_t slope);
 
+                static inline uint64_t  profile_time();
+
             protected:
+                inline uint64_t     profile_stage(size_t stage, uint64_t start);
+                void                update_profile(size_t samples);
                 void                do_destroy();
+                bool                init_analyzer();
                 void                perform_analysis(size_t samples);
-                void                process_channel(eq_channel_t *c, size_t start, size_t samples, size_t total_samples);
+                void                process_analysis();
+                void                complete_analysis();
+                void                submit_analysis();
+                void                submit_analysis_task();
+                void                wait_analysis();
+                void                output_meshes();
+                void                process_design();
+                void                design_kernel(kernel_buf_t *kb, dspu::Equalizer *eq, float sample_rate, size_t rank, size_t kernel, size_t decramp);
+                bool                alloc_kernel(kernel_buf_t *kb, size_t rank);
+                void                free_kernel(kernel_buf_t *kb);
+                void                init_convolver(dspu::Convolver *conv, const kernel_buf_t *kb, size_t rank);
+                bool                init_equalizer(dspu::Equalizer *eq, size_t rank);
+                float               estimate_decay(const eq_channel_t *c, float sample_rate) const;
+                size_t              select_kernel_rank(size_t rank) const;
+                bool                check_idle(size_t samples);
+                size_t              equalizer_latency(eq_channel_t *c);
+                size_t              path_latency(dspu::Oversampler *ovs, dspu::Equalizer *eq, size_t kernel, size_t rank);
+                size_t              reserve_latency(size_t latency, size_t ovs_latency, dspu::equalizer_mode_t mode, size_t kernel) const;
+                void                update_latency();
+                void                output_latency();
+                void                complete_design();
+                void                submit_design();
+                void                wait_design();
+                void                start_warmup();
+                void                request_design(eq_channel_t *c, size_t index);
+                void                advance_design(eq_channel_t *c);
+                void                process_input(size_t samples);
+                void                process_bypass(size_t samples);
+                void                fade_out(size_t samples);
+                void                update_inline_display(size_t samples);
+                void                preroll(size_t offset);
+                void                process_identity(eq_channel_t *c, size_t offset, size_t samples);
+                bool                update_identity(eq_channel_t *gc, size_t links);
+                void                advance_identity(eq_channel_t *gc, size_t samples);
+                void                process_channels(size_t samples);
+                void                process_filters(eq_channel_t *gc, size_t links, size_t offset, size_t samples);
+                uint64_t            process_oversampled(eq_channel_t *gc, size_t links, size_t offset, size_t samples, uint64_t ts);
+                void                equalize(eq_channel_t *c, float *dst, const float *src, size_t count);
+                void                process_resample(eq_channel_t *c, size_t offset, size_t samples);
+                void                calc_filter_params(eq_channel_t *c, size_t index);
+                void                start_ramp(eq_channel_t *c, size_t index, size_t length, size_t links);
+                void                reset_ramp(eq_channel_t *c, size_t index, size_t links);
+                void                advance_ramp(eq_channel_t *c, size_t index, size_t links);
                 uint32_t            calc_decramping();
+                uint32_t            calc_auto_decramping(size_t decramp) const;
+                void                apply_decramping();
 
                 void                dump_channel(dspu::IStateDumper *v, const eq_channel_t *c) const;
+                static void         dump_filter(dspu::IStateDumper *v, const eq_filter_t *f);
                 static void         dump_filter_params(dspu::IStateDumper *v, const char *id, const dspu::filter_params_t *fp);
-                static dspu::over_mode_t    calc_oversampler_mode(dspu::equalizer_mode_t eq_mode, size_t decramp);
+                static void         dump_ramp(dspu::IStateDumper *v, const char *id, const filter_ramp_t *r);
+                static dspu::over_mode_t    calc_oversampler_mode(dspu::equalizer_mode_t eq_mode, size_t kernel, size_t decramp, size_t quality);
+
+            public:
+                static size_t       select_fft_rank(size_t resolution, float sample_rate);
 
             public:
-                explicit filter(const meta::plugin_t *metadata, size_t mode);
+                explicit filter(const meta::plugin_t *metadata, size_t channels, size_t filters, size_t mode);
                 virtual ~filter() override;
 
             public:
@@ -155,6 +428,7 @@ namespace lsp
                 virtual void        destroy() override;
                 virtual void        ui_activated() override;
                 virtual void        ui_deactivated() override;
+                virtual void        deactivated() override;
 
                 virtual void        update_settings() override;
                 virtual void        update_sample_rate(long sr) override;
@@ -1,7 +1,8 @@
 <?php
 	plugin_header();
 	
-	$m      =   (strpos($PAGE, '_mono') > 0) ? 'm' : 's';
+	$m      =   (strpos($PAGE, '_mono') > 0) ? 'm' :
+				(strpos($PAGE, '_multi') > 0) ? 'mc' : 's';
 ?>
 <?php require_once("${DOC_BASE}/manuals/common/filters.php"); ?>
 <p>
@@ -21,7 +22,20 @@
     <li><b>Direct Design (DR) filters</b> add alternative implementations for the various supperted filter types, and may be chosen whenever their frequency response is best suited.</li>
 </ul>
 <p>
-	This plugin introduces a single filter.
+	This plugin introduces a single filter. The <b>x4</b> versions of the plugin provide four independent filters which are applied
+	to the signal one after another. All filters share the same oversampling (decramping) and latency compensation, so building
+	a chain of filters with the single <b>x4</b> instance costs less CPU and adds less latency than chaining several instances
+	of the plugin.
+</p>
+<p>
+	The <b>LeftRight</b> version of the plugin allows to set up independent filters for the left and right channels. The <b>MidSide</b>
+	version converts the stereo signal into the mid and side channels, applies the independent filter to each of them and converts the
+	result back to the stereo signal.
+</p>
+<p>
+	The <b>Multichannel</b> versions of the plugin apply the same filter to all 8 or 16 channels of the signal, for example to the
+	surround or ambisonic bed. The filter is designed once and shared by all channels. Spectral analysis is performed for one
+	selected channel only, and signal level metering is disabled by default to save CPU.
 </p>
 <p>The steepness of the filter is depending on the type of the filter selected, it's slope and Q factor.<p>
 <p>There is a simple rule that allows to compute the steepness of IIR (recursive) low-pass or high-pass filter which consists
@@ -141,8 +155,23 @@ sample rate is greater than the actual sample rate, the proper oversampling coef
 		<li><b>FIR</b> - Finite Impulse Response filters with linear phase, finite approximation of equalizer's impulse response. Adds noticeable latency to output signal.</li>
 		<li><b>FFT</b> - Fast Fourier Transform approximation of the frequency chart, linear phase. Adds noticeable latency to output signal.</li>
 		<li><b>SPM</b> - Spectral Processor Mode of equalizer, equalizer transforms the magnitude of signal spectrum instead of applying impulse response to the signal.</li>
+		<li><b>HLP</b> - Hybrid Linear Phase, the linear phase kernel is applied by the partitioned convolution. Unlike FIR and FFT modes the latency does not depend on the processing block and equals to the half of the kernel length.</li>
+		<li><b>HMP</b> - Hybrid Minimum Phase, the kernel is the impulse response of IIR filters applied by the partitioned convolution. Does not add latency to output signal.</li>
 	</ul>
-	<li><b>Decramp</b> - Enables decramping of filter transfer functions inside of the audible frequency range by applying oversampling.</li>
+	<li>In <b>FIR</b>, <b>FFT</b>, <b>SPM</b>, <b>HLP</b> and <b>HMP</b> modes the new filter kernel is computed in background when the filter parameters change,
+	the current kernel keeps playing meanwhile and is replaced by the new one with a crossfade. The length of the kernel is selected
+	automatically depending on the frequency, slope and quality factor of the filter and the sample rate, so low-frequency filters get longer
+	kernels while high-frequency filters have shorter latency. The latency reported to the host follows the length of the kernel.</li>
+	<li><b>Decramp</b> - Enables decramping of filter transfer functions inside of the audible frequency range by applying oversampling.
+	In <b>HLP</b> and <b>HMP</b> modes the kernel is designed from the decramped magnitude response and applied without oversampling.
+	The <b>Auto</b> setting selects the minimum oversampling that keeps the cramping error of the filters low enough depending on their type,
+	frequency, quality factor and slope. When the automatically selected oversampling changes, the filters with the new oversampling
+	are crossfaded with the active ones, and the lower oversampling is selected only when the error gets noticeably smaller.</li>
+	<li><b>Resampler</b> - the quality of the resampling kernel used by decramping. Lower settings use shorter kernels which reduce
+	the latency and the CPU load at the cost of aliasing suppression; <b>High</b> matches the behaviour of previous versions.</li>
+	<li><b>Smoothing</b> - the time of smooth transition between previous and new settings of the filter when changing
+	frequency, gain or quality factor. In IIR mode the filter is redesigned step by step, the transition is independent of the block size
+	used by the host. In other modes the output of the current kernel is crossfaded with the output of the new one.</li>
 	<?php if ($m == 's') { ?>
 	<li><b>Left</b> - enables the <?php if ($m != 's') echo "frequency chart and "; ?>FFT analysis for the left channel.</li>
 	<li><b>Right</b> - enables the <?php if ($m != 's') echo "frequency chart and "; ?>FFT analysis for the right channel.</li>
@@ -154,17 +183,39 @@ sample rate is greater than the actual sample rate, the proper oversampling coef
 	<li><b>FFT</b> - enables FFT analysis before or after processing.</li>
 	<li><b>Reactivity</b> - the reactivity (smoothness) of the spectral analysis.</li>
 	<li><b>Shift</b> - allows to adjust the overall gain of the analysis.</li>
+	<li><b>FFT resolution</b> - the size of the FFT frame used by the spectral analysis. The <b>Auto</b> setting selects the size depending
+	on the resolution of the graph at the lowest displayed frequency and the refresh rate of the graph, the size does not grow
+	with the sample rate.</li>
+	<?php if ($m == 'mc') { ?>
+	<li><b>Channel</b> - the number of the channel which is passed to the spectral analysis.</li>
+	<?php } ?>
 </ul>
+<p><b>DSP load profiling:</b></p>
+<p>The plugin provides additional <b>Profiling</b> switch which is not shown in the main window. When enabled, the plugin measures the time
+spent by each processing stage (dry delay, input stage, oversampler, equalizer, passing data to the analyzer, output stage) and reports it through
+the additional meters as a percentage of the realtime duration of the processed block. The profiling is disabled by default and
+does not add processing overhead when disabled.</p>
+<p><b>Latency:</b></p>
+<p>The latency reported to the host is the sum of latencies of the decramping oversampler and of the equalizer, both expressed
+in samples of the host sample rate. The total latency and the latency of each stage are reported through additional meters
+which are not shown in the main window. The host is notified only when the total latency changes.</p>
+<p>When neither the plugin window nor the inline display is shown, the plugin does not perform spectral analysis and does not
+compute graphs to save CPU. The graphs are updated as soon as the window or the inline display appears.</p>
 <p><b>'Signal' section:</b></p>
 <ul>
 	<li><b>Input</b> - input signal amplification.</li>
 	<li><b>Output</b> - output signal amplification.</li>
 	<?php if ($m == 's') { ?>
 	<li><b>Balance</b> - balance between left and right output channels.</li>
+	<?php } elseif ($m == 'mc') { ?>
+	<li><b>Meters</b> - enables the input and output signal level meters of each channel.</li>
 	<?php } ?>
 </ul>
 <p><b>'Filters controls' section:</b></p>
 <ul>
+	<?php if (strpos($PAGE, '_x4') > 0) { ?>
+	<li><b>On</b> - enables the corresponding filter.</li>
+	<?php } ?>
 	<li><b>Filter</b> - sets up the mode of the selected filter. Currently available filters:</li>
 	<ul>
 		<li><b>Lo-pass</b> - Low-pass filter with rejection of high frequencies.</li>
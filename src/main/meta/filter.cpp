@@ -26,7 +26,7 @@
 
 #define LSP_PLUGINS_FILTER_VERSION_MAJOR         1
 #define LSP_PLUGINS_FILTER_VERSION_MINOR         0
-#define LSP_PLUGINS_FILTER_VERSION_MICRO         24
+#define LSP_PLUGINS_FILTER_VERSION_MICRO         25
 
 #define LSP_PLUGINS_FILTER_VERSION  \
     LSP_MODULE_VERSION( \
@@ -42,12 +42,16 @@ namespace lsp
         // Different revisions
         #define REV_0           0
         #define REV_1           1
+        #define REV_2           2
+        #define REV_3           3
+        #define REV_4           4
 
         //-------------------------------------------------------------------------
         // Parametric Equalizer
         static const int plugin_classes[]           = { C_PARA_EQ, -1 };
         static const int clap_features_mono[]       = { CF_AUDIO_EFFECT, CF_EQUALIZER, CF_MONO, -1 };
         static const int clap_features_stereo[]     = { CF_AUDIO_EFFECT, CF_EQUALIZER, CF_STEREO, -1 };
+        static const int clap_features_multi[]      = { CF_AUDIO_EFFECT, CF_EQUALIZER, CF_SURROUND, -1 };
 
         static const port_item_t filter_slopes[] =
         {
@@ -68,6 +72,8 @@ namespace lsp
             { "FIR",            "filter.type.fir" },
             { "FFT",            "filter.type.fft" },
             { "SPM",            "filter.type.spm" },
+            { "HLP",            "filter.type.hlp" },
+            { "HMP",            "filter.type.hmp" },
             { NULL, NULL }
         };
 
@@ -107,17 +113,51 @@ namespace lsp
             { "x4",             "eq.decramp.x4"     },
             { "x6",             "eq.decramp.x6"     },
             { "x8",             "eq.decramp.x8"     },
+            { "Auto",           "filter.decramp.auto" },
             { NULL, NULL }
         };
 
+        static const port_item_t filter_resampler_quality[] =
+        {
+            { "Fast",           "filter.rsq.fast"   },
+            { "Low",            "filter.rsq.low"    },
+            { "Medium",         "filter.rsq.medium" },
+            { "High",           "filter.rsq.high"   },
+            { "Best",           "filter.rsq.best"   },
+            { NULL, NULL }
+        };
+
+        static const port_item_t filter_fft_resolutions[] =
+        {
+            { "Auto",           "filter.fft.auto"   },
+            { "2048",           NULL                },
+            { "4096",           NULL                },
+            { "8192",           NULL                },
+            { "16384",          NULL                },
+            { NULL, NULL }
+        };
+
+        #define EQ_FILTER_CH(id, label, alias) \
+                COMBO("ft" id, "Filter type" label, "Type" alias, 0, filter_types), \
+                COMBO("fm" id, "Filter mode" label, "Mode" alias, 0, filter_modes), \
+                COMBO("s" id, "Filter slope" label, "Slope" alias, 0, filter_slopes), \
+                LOG_CONTROL("f" id, "Frequency" label, "Frequency" alias, U_HZ, filter_metadata::FREQ), \
+                CONTROL("w" id, "Filter Width" label, "Width" alias, U_OCTAVES, filter_metadata::WIDTH), \
+                LOG_CONTROL_ALL("g" id, "Gain" label, "Gain" alias, U_GAIN_AMP, GAIN_AMP_M_36_DB, GAIN_AMP_P_36_DB, GAIN_AMP_0_DB, 0.01), \
+                CONTROL_ALL("q" id, "Quality factor" label, "Q" alias, U_NONE, 0.0f, 100.0f, 0.0f, 0.025f)
+
         #define EQ_FILTER \
-                COMBO("ft", "Filter type", "Type", 0, filter_types), \
-                COMBO("fm", "Filter mode", "Mode", 0, filter_modes), \
-                COMBO("s", "Filter slope", "Slope", 0, filter_slopes), \
-                LOG_CONTROL("f", "Frequency", "Frequency", U_HZ, filter_metadata::FREQ), \
-                CONTROL("w", "Filter Width", "Width", U_OCTAVES, filter_metadata::WIDTH), \
-                LOG_CONTROL_ALL("g", "Gain", "Gain", U_GAIN_AMP, GAIN_AMP_M_36_DB, GAIN_AMP_P_36_DB, GAIN_AMP_0_DB, 0.01), \
-                CONTROL_ALL("q", "Quality factor", "Q", U_NONE, 0.0f, 100.0f, 0.0f, 0.025f)
+                EQ_FILTER_CH("", "", "")
+
+        #define EQ_FILTER_SLOT(id, label, alias, on) \
+                SWITCH("fe" id, "Filter enable" label, "On" alias, on), \
+                EQ_FILTER_CH(id, label, alias)
+
+        #define EQ_FILTER_X4 \
+                EQ_FILTER_SLOT("_0", " 0", " 0", 1.0f), \
+                EQ_FILTER_SLOT("_1", " 1", " 1", 0.0f), \
+                EQ_FILTER_SLOT("_2", " 2", " 2", 0.0f), \
+                EQ_FILTER_SLOT("_3", " 3", " 3", 0.0f)
 
         #define EQ_COMMON \
                 BYPASS, \
@@ -125,7 +165,10 @@ namespace lsp
                 AMP_GAIN("g_out", "Output gain", "Output gain", filter_metadata::OUT_GAIN_DFL, 10.0f), \
                 COMBO("mode", "Filter mode", "Filter mode", 0, filter_eq_modes), \
                 ADDON_COMBO(REV_1, "decramp", "Equalizer decramping", "Decramping", 0, filter_decramping), \
+                ADDON_COMBO(REV_2, "rsq", "Decramping resampler quality", "Resampler", filter_metadata::RESAMPLER_DFL, filter_resampler_quality), \
+                ADDON_CONTROL(REV_3, "smooth", "Parameter smoothing time", "Smoothing", U_MSEC, filter_metadata::SMOOTH_TIME), \
                 LOG_CONTROL("react", "FFT reactivity", "Reactivity", U_MSEC, filter_metadata::REACT_TIME), \
+                ADDON_COMBO(REV_4, "fftr", "FFT resolution", "FFT res", filter_metadata::FFT_RES_DFL, filter_fft_resolutions), \
                 AMP_GAIN("shift", "Shift gain", "Shift", 1.0f, 100.0f), \
                 LOG_CONTROL("zoom", "Graph zoom", "Zoom", U_GAIN_AMP, filter_metadata::ZOOM)
 
@@ -142,6 +185,124 @@ namespace lsp
                 METER_GAIN("imr", "Input signal meter Right", GAIN_AMP_P_12_DB), \
                 METER_GAIN("smr", "Output signal meter Right", GAIN_AMP_P_12_DB)
 
+        #define EQ_SPLIT_PORTS(ida, idb, la, lb) \
+                PAN_CTL("bal", "Output balance", "Out balance", 0.0f), \
+                MESH("ag" ida, "Amplitude graph" la, 2, filter_metadata::MESH_POINTS + 4), \
+                METER_GAIN("iml", "Input signal meter Left", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sml", "Output signal meter Left", GAIN_AMP_P_12_DB), \
+                MESH("ag" idb, "Amplitude graph" lb, 2, filter_metadata::MESH_POINTS + 4), \
+                METER_GAIN("imr", "Input signal meter Right", GAIN_AMP_P_12_DB), \
+                METER_GAIN("smr", "Output signal meter Right", GAIN_AMP_P_12_DB)
+
+        #define MULTI_AUDIO_X8 \
+                AUDIO_INPUT("in_0", "Input 1", "In 1"), \
+                AUDIO_INPUT("in_1", "Input 2", "In 2"), \
+                AUDIO_INPUT("in_2", "Input 3", "In 3"), \
+                AUDIO_INPUT("in_3", "Input 4", "In 4"), \
+                AUDIO_INPUT("in_4", "Input 5", "In 5"), \
+                AUDIO_INPUT("in_5", "Input 6", "In 6"), \
+                AUDIO_INPUT("in_6", "Input 7", "In 7"), \
+                AUDIO_INPUT("in_7", "Input 8", "In 8"), \
+                AUDIO_OUTPUT("out_0", "Output 1", "Out 1"), \
+                AUDIO_OUTPUT("out_1", "Output 2", "Out 2"), \
+                AUDIO_OUTPUT("out_2", "Output 3", "Out 3"), \
+                AUDIO_OUTPUT("out_3", "Output 4", "Out 4"), \
+                AUDIO_OUTPUT("out_4", "Output 5", "Out 5"), \
+                AUDIO_OUTPUT("out_5", "Output 6", "Out 6"), \
+                AUDIO_OUTPUT("out_6", "Output 7", "Out 7"), \
+                AUDIO_OUTPUT("out_7", "Output 8", "Out 8")
+
+        #define MULTI_AUDIO_X16 \
+                AUDIO_INPUT("in_0", "Input 1", "In 1"), \
+                AUDIO_INPUT("in_1", "Input 2", "In 2"), \
+                AUDIO_INPUT("in_2", "Input 3", "In 3"), \
+                AUDIO_INPUT("in_3", "Input 4", "In 4"), \
+                AUDIO_INPUT("in_4", "Input 5", "In 5"), \
+                AUDIO_INPUT("in_5", "Input 6", "In 6"), \
+                AUDIO_INPUT("in_6", "Input 7", "In 7"), \
+                AUDIO_INPUT("in_7", "Input 8", "In 8"), \
+                AUDIO_INPUT("in_8", "Input 9", "In 9"), \
+                AUDIO_INPUT("in_9", "Input 10", "In 10"), \
+                AUDIO_INPUT("in_10", "Input 11", "In 11"), \
+                AUDIO_INPUT("in_11", "Input 12", "In 12"), \
+                AUDIO_INPUT("in_12", "Input 13", "In 13"), \
+                AUDIO_INPUT("in_13", "Input 14", "In 14"), \
+                AUDIO_INPUT("in_14", "Input 15", "In 15"), \
+                AUDIO_INPUT("in_15", "Input 16", "In 16"), \
+                AUDIO_OUTPUT("out_0", "Output 1", "Out 1"), \
+                AUDIO_OUTPUT("out_1", "Output 2", "Out 2"), \
+                AUDIO_OUTPUT("out_2", "Output 3", "Out 3"), \
+                AUDIO_OUTPUT("out_3", "Output 4", "Out 4"), \
+                AUDIO_OUTPUT("out_4", "Output 5", "Out 5"), \
+                AUDIO_OUTPUT("out_5", "Output 6", "Out 6"), \
+                AUDIO_OUTPUT("out_6", "Output 7", "Out 7"), \
+                AUDIO_OUTPUT("out_7", "Output 8", "Out 8"), \
+                AUDIO_OUTPUT("out_8", "Output 9", "Out 9"), \
+                AUDIO_OUTPUT("out_9", "Output 10", "Out 10"), \
+                AUDIO_OUTPUT("out_10", "Output 11", "Out 11"), \
+                AUDIO_OUTPUT("out_11", "Output 12", "Out 12"), \
+                AUDIO_OUTPUT("out_12", "Output 13", "Out 13"), \
+                AUDIO_OUTPUT("out_13", "Output 14", "Out 14"), \
+                AUDIO_OUTPUT("out_14", "Output 15", "Out 15"), \
+                AUDIO_OUTPUT("out_15", "Output 16", "Out 16")
+
+        #define EQ_MULTI_PORTS(channels) \
+                INT_CONTROL_ALL("fftc", "Analyzed channel", "FFT channel", U_NONE, 1, channels, 1, 1), \
+                SWITCH("mtr", "Signal level metering", "Metering", 0.0f), \
+                MESH("ag", "Amplitude graph", 2, filter_metadata::MESH_POINTS + 4)
+
+        #define MULTI_METERS_X8 \
+                METER_GAIN("im_0", "Input signal meter 1", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_0", "Output signal meter 1", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_1", "Input signal meter 2", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_1", "Output signal meter 2", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_2", "Input signal meter 3", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_2", "Output signal meter 3", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_3", "Input signal meter 4", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_3", "Output signal meter 4", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_4", "Input signal meter 5", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_4", "Output signal meter 5", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_5", "Input signal meter 6", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_5", "Output signal meter 6", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_6", "Input signal meter 7", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_6", "Output signal meter 7", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_7", "Input signal meter 8", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_7", "Output signal meter 8", GAIN_AMP_P_12_DB)
+
+        #define MULTI_METERS_X16 \
+                METER_GAIN("im_0", "Input signal meter 1", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_0", "Output signal meter 1", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_1", "Input signal meter 2", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_1", "Output signal meter 2", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_2", "Input signal meter 3", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_2", "Output signal meter 3", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_3", "Input signal meter 4", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_3", "Output signal meter 4", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_4", "Input signal meter 5", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_4", "Output signal meter 5", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_5", "Input signal meter 6", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_5", "Output signal meter 6", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_6", "Input signal meter 7", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_6", "Output signal meter 7", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_7", "Input signal meter 8", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_7", "Output signal meter 8", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_8", "Input signal meter 9", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_8", "Output signal meter 9", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_9", "Input signal meter 10", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_9", "Output signal meter 10", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_10", "Input signal meter 11", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_10", "Output signal meter 11", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_11", "Input signal meter 12", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_11", "Output signal meter 12", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_12", "Input signal meter 13", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_12", "Output signal meter 13", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_13", "Input signal meter 14", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_13", "Output signal meter 14", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_14", "Input signal meter 15", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_14", "Output signal meter 15", GAIN_AMP_P_12_DB), \
+                METER_GAIN("im_15", "Input signal meter 16", GAIN_AMP_P_12_DB), \
+                METER_GAIN("sm_15", "Output signal meter 16", GAIN_AMP_P_12_DB)
+
         #define CHANNEL_ANALYSIS(id, label, alias) \
                 SWITCH("ife" id, "Input FFT graph enable" label, "Show FFT In" alias, 1.0f), \
                 SWITCH("ofe" id, "Output FFT graph enable" label, "Show FFT Out" alias, 1.0f), \
@@ -149,6 +310,20 @@ namespace lsp
                 MESH("ofg" id, "Output FFT graph" label, 2, filter_metadata::MESH_POINTS)
 
 
+        #define LATENCY_METERS \
+                METER("lat", "Latency", U_MSEC, filter_metadata::LATENCY), \
+                METER("lat_ovs", "Oversampler latency", U_MSEC, filter_metadata::LATENCY), \
+                METER("lat_eq", "Equalizer latency", U_MSEC, filter_metadata::LATENCY)
+
+        #define DSP_LOAD_METERS \
+                SWITCH("prof", "DSP load profiling", "Profiling", 0.0f), \
+                METER("ld_dly", "Dry delay DSP load", U_PERCENT, filter_metadata::DSP_LOAD), \
+                METER("ld_in", "Input stage DSP load", U_PERCENT, filter_metadata::DSP_LOAD), \
+                METER("ld_ovs", "Oversampler DSP load", U_PERCENT, filter_metadata::DSP_LOAD), \
+                METER("ld_eq", "Equalizer DSP load", U_PERCENT, filter_metadata::DSP_LOAD), \
+                METER("ld_an", "Analyzer DSP load", U_PERCENT, filter_metadata::DSP_LOAD), \
+                METER("ld_out", "Output stage DSP load", U_PERCENT, filter_metadata::DSP_LOAD)
+
         static const port_t filter_mono_ports[] =
         {
             PORTS_MONO_PLUGIN,
@@ -156,6 +331,8 @@ namespace lsp
             CHANNEL_ANALYSIS("", " ", ""),
             EQ_MONO_PORTS,
             EQ_FILTER,
+            LATENCY_METERS,
+            DSP_LOAD_METERS,
 
             PORTS_END
         };
@@ -168,6 +345,93 @@ namespace lsp
             CHANNEL_ANALYSIS("_r", " Right", " R"),
             EQ_STEREO_PORTS,
             EQ_FILTER,
+            LATENCY_METERS,
+            DSP_LOAD_METERS,
+
+            PORTS_END
+        };
+
+        static const port_t filter_x4_mono_ports[] =
+        {
+            PORTS_MONO_PLUGIN,
+            EQ_COMMON,
+            CHANNEL_ANALYSIS("", " ", ""),
+            EQ_MONO_PORTS,
+            EQ_FILTER_X4,
+            LATENCY_METERS,
+            DSP_LOAD_METERS,
+
+            PORTS_END
+        };
+
+        static const port_t filter_x4_stereo_ports[] =
+        {
+            PORTS_STEREO_PLUGIN,
+            EQ_COMMON,
+            CHANNEL_ANALYSIS("_l", " Left", " L"),
+            CHANNEL_ANALYSIS("_r", " Right", " R"),
+            EQ_STEREO_PORTS,
+            EQ_FILTER_X4,
+            LATENCY_METERS,
+            DSP_LOAD_METERS,
+
+            PORTS_END
+        };
+
+        static const port_t filter_lr_ports[] =
+        {
+            PORTS_STEREO_PLUGIN,
+            EQ_COMMON,
+            CHANNEL_ANALYSIS("_l", " Left", " L"),
+            CHANNEL_ANALYSIS("_r", " Right", " R"),
+            EQ_SPLIT_PORTS("_l", "_r", " Left", " Right"),
+            EQ_FILTER_CH("_l", " Left", " L"),
+            EQ_FILTER_CH("_r", " Right", " R"),
+            LATENCY_METERS,
+            DSP_LOAD_METERS,
+
+            PORTS_END
+        };
+
+        static const port_t filter_ms_ports[] =
+        {
+            PORTS_STEREO_PLUGIN,
+            EQ_COMMON,
+            CHANNEL_ANALYSIS("_m", " Mid", " M"),
+            CHANNEL_ANALYSIS("_s", " Side", " S"),
+            EQ_SPLIT_PORTS("_m", "_s", " Mid", " Side"),
+            EQ_FILTER_CH("_m", " Mid", " M"),
+            EQ_FILTER_CH("_s", " Side", " S"),
+            LATENCY_METERS,
+            DSP_LOAD_METERS,
+
+            PORTS_END
+        };
+
+        static const port_t filter_x8_multi_ports[] =
+        {
+            MULTI_AUDIO_X8,
+            EQ_COMMON,
+            CHANNEL_ANALYSIS("", " ", ""),
+            EQ_MULTI_PORTS(8),
+            MULTI_METERS_X8,
+            EQ_FILTER,
+            LATENCY_METERS,
+            DSP_LOAD_METERS,
+
+            PORTS_END
+        };
+
+        static const port_t filter_x16_multi_ports[] =
+        {
+            MULTI_AUDIO_X16,
+            EQ_COMMON,
+            CHANNEL_ANALYSIS("", " ", ""),
+            EQ_MULTI_PORTS(16),
+            MULTI_METERS_X16,
+            EQ_FILTER,
+            LATENCY_METERS,
+            DSP_LOAD_METERS,
 
             PORTS_END
         };
@@ -245,5 +509,197 @@ namespace lsp
         };
         LSP_REGISTER_METADATA(filter_stereo);
 
+        const meta::plugin_t filter_x4_mono =
+        {
+            "Filter x4 Mono",
+            "Filter x4 Mono",
+            "Filter x4 Mono",
+            "FX4M",
+            &developers::v_sadovnikov,
+            "filter_x4_mono",
+            {
+                LSP_LV2_URI("filter_x4_mono"),
+                LSP_LV2UI_URI("filter_x4_mono"),
+                "flx4",
+                LSP_VST3_UID("flx4m   flx4"),
+                LSP_VST3UI_UID("flx4m   flx4"),
+                LSP_LADSPA_FILTER_BASE + 2,
+                LSP_LADSPA_URI("filter_x4_mono"),
+                LSP_CLAP_URI("filter_x4_mono"),
+                LSP_GST_UID("filter_x4_mono"),
+            },
+            LSP_PLUGINS_FILTER_VERSION,
+            plugin_classes,
+            clap_features_mono,
+            E_INLINE_DISPLAY | E_DUMP_STATE,
+            filter_x4_mono_ports,
+            "plugins/equalizer/filter/filter_x4.xml",
+            NULL,
+            mono_plugin_port_groups,
+            &filter_bundle,
+            2
+        };
+        LSP_REGISTER_METADATA(filter_x4_mono);
+
+        const meta::plugin_t filter_x4_stereo =
+        {
+            "Filter x4 Stereo",
+            "Filter x4 Stereo",
+            "Filter x4 Stereo",
+            "FX4S",
+            &developers::v_sadovnikov,
+            "filter_x4_stereo",
+            {
+                LSP_LV2_URI("filter_x4_stereo"),
+                LSP_LV2UI_URI("filter_x4_stereo"),
+                "fls4",
+                LSP_VST3_UID("flx4s   fls4"),
+                LSP_VST3UI_UID("flx4s   fls4"),
+                LSP_LADSPA_FILTER_BASE + 3,
+                LSP_LADSPA_URI("filter_x4_stereo"),
+                LSP_CLAP_URI("filter_x4_stereo"),
+                LSP_GST_UID("filter_x4_stereo"),
+            },
+            LSP_PLUGINS_FILTER_VERSION,
+            plugin_classes,
+            clap_features_stereo,
+            E_INLINE_DISPLAY | E_DUMP_STATE,
+            filter_x4_stereo_ports,
+            "plugins/equalizer/filter/filter_x4.xml",
+            NULL,
+            stereo_plugin_port_groups,
+            &filter_bundle,
+            1
+        };
+        LSP_REGISTER_METADATA(filter_x4_stereo);
+
+        const meta::plugin_t filter_lr =
+        {
+            "Filter LeftRight",
+            "Filter LeftRight",
+            "Filter LeftRight",
+            "FLTLR",
+            &developers::v_sadovnikov,
+            "filter_lr",
+            {
+                LSP_LV2_URI("filter_lr"),
+                LSP_LV2UI_URI("filter_lr"),
+                "fllr",
+                LSP_VST3_UID("fllr    fllr"),
+                LSP_VST3UI_UID("fllr    fllr"),
+                LSP_LADSPA_FILTER_BASE + 4,
+                LSP_LADSPA_URI("filter_lr"),
+                LSP_CLAP_URI("filter_lr"),
+                LSP_GST_UID("filter_lr"),
+            },
+            LSP_PLUGINS_FILTER_VERSION,
+            plugin_classes,
+            clap_features_stereo,
+            E_INLINE_DISPLAY | E_DUMP_STATE,
+            filter_lr_ports,
+            "plugins/equalizer/filter/filter_lr.xml",
+            NULL,
+            stereo_plugin_port_groups,
+            &filter_bundle,
+            1
+        };
+        LSP_REGISTER_METADATA(filter_lr);
+
+        const meta::plugin_t filter_ms =
+        {
+            "Filter MidSide",
+            "Filter MidSide",
+            "Filter MidSide",
+            "FLTMS",
+            &developers::v_sadovnikov,
+            "filter_ms",
+            {
+                LSP_LV2_URI("filter_ms"),
+                LSP_LV2UI_URI("filter_ms"),
+                "flms",
+                LSP_VST3_UID("flms    flms"),
+                LSP_VST3UI_UID("flms    flms"),
+                LSP_LADSPA_FILTER_BASE + 5,
+                LSP_LADSPA_URI("filter_ms"),
+                LSP_CLAP_URI("filter_ms"),
+                LSP_GST_UID("filter_ms"),
+            },
+            LSP_PLUGINS_FILTER_VERSION,
+            plugin_classes,
+            clap_features_stereo,
+            E_INLINE_DISPLAY | E_DUMP_STATE,
+            filter_ms_ports,
+            "plugins/equalizer/filter/filter_ms.xml",
+            NULL,
+            stereo_plugin_port_groups,
+            &filter_bundle,
+            1
+        };
+        LSP_REGISTER_METADATA(filter_ms);
+
+        const meta::plugin_t filter_x8_multi =
+        {
+            "Filter x8 Multichannel",
+            "Filter x8 Multichannel",
+            "Filter x8 Multichannel",
+            "FLTX8M",
+            &developers::v_sadovnikov,
+            "filter_x8_multi",
+            {
+                LSP_LV2_URI("filter_x8_multi"),
+                LSP_LV2UI_URI("filter_x8_multi"),
+                "flx8",
+                LSP_VST3_UID("flx8m   flx8"),
+                LSP_VST3UI_UID("flx8m   flx8"),
+                LSP_LADSPA_FILTER_BASE + 6,
+                LSP_LADSPA_URI("filter_x8_multi"),
+                LSP_CLAP_URI("filter_x8_multi"),
+                LSP_GST_UID("filter_x8_multi"),
+            },
+            LSP_PLUGINS_FILTER_VERSION,
+            plugin_classes,
+            clap_features_multi,
+            E_INLINE_DISPLAY | E_DUMP_STATE,
+            filter_x8_multi_ports,
+            "plugins/equalizer/filter/filter_multi.xml",
+            NULL,
+            NULL,
+            &filter_bundle,
+            1
+        };
+        LSP_REGISTER_METADATA(filter_x8_multi);
+
+        const meta::plugin_t filter_x16_multi =
+        {
+            "Filter x16 Multichannel",
+            "Filter x16 Multichannel",
+            "Filter x16 Multichannel",
+            "FLTX16M",
+            &developers::v_sadovnikov,
+            "filter_x16_multi",
+            {
+                LSP_LV2_URI("filter_x16_multi"),
+                LSP_LV2UI_URI("filter_x16_multi"),
+                "flxg",
+                LSP_VST3_UID("flx16m  flxg"),
+                LSP_VST3UI_UID("flx16m  flxg"),
+                LSP_LADSPA_FILTER_BASE + 7,
+                LSP_LADSPA_URI("filter_x16_multi"),
+                LSP_CLAP_URI("filter_x16_multi"),
+                LSP_GST_UID("filter_x16_multi"),
+            },
+            LSP_PLUGINS_FILTER_VERSION,
+            plugin_classes,
+            clap_features_multi,
+            E_INLINE_DISPLAY | E_DUMP_STATE,
+            filter_x16_multi_ports,
+            "plugins/equalizer/filter/filter_multi.xml",
+            NULL,
+            NULL,
+            &filter_bundle,
+            1
+        };
+        LSP_REGISTER_METADATA(filter_x16_multi);
+
     } /* namespace meta */
 } /* namespace lsp */
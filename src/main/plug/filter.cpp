@@ -19,10 +19,15 @@
  * along with lsp-plugins-filter. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <chrono>
+
 #include <lsp-plug.in/common/alloc.h>
 #include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/dsp-units/misc/windows.h>
 #include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/ipc/IExecutor.h>
+#include <lsp-plug.in/ipc/Thread.h>
 #include <lsp-plug.in/stdlib/math.h>
 
 #include <lsp-plug.in/shared/debug.h>
@@ -36,7 +41,25 @@ namespace lsp
     {
         constexpr static size_t EQ_BUFFER_SIZE      = 0x400U;
         constexpr static size_t EQ_RANK             = 12;
+        constexpr static size_t EQ_RANK_MIN         = 8;
+        constexpr static size_t EQ_RANK_MAX         = 15;
+        constexpr static size_t EQ_RANK_HYSTERESIS  = 2;
+        constexpr static float  EQ_KERNEL_PERIODS   = 4.0f;
         constexpr static size_t EQ_SMOOTH_STEP      = 32;
+        constexpr static size_t EQ_SMOOTH_POINTS    = 64;
+        constexpr static size_t EQ_ANALYSIS_RING    = 0x4000U;
+        constexpr static float  EQ_IDISPLAY_TIMEOUT = 1.0f;
+        constexpr static float  EQ_FFT_PERIODS      = 4.0f;
+        constexpr static float  EQ_DECRAMP_ERROR    = 0.05f;
+        constexpr static float  EQ_DECRAMP_HYST     = 0.5f;
+        constexpr static float  EQ_DECRAMP_Q_MIN    = 0.1f;
+        constexpr static float  EQ_DECRAMP_W_MAX    = 1.5f;
+        constexpr static float  EQ_SILENCE_LEVEL    = 1e-6f; // -120 dB
+        constexpr static size_t EQ_KERNEL_SIZE      = 1 << EQ_RANK_MAX;
+        constexpr static size_t EQ_CONV_RANK        = 8;
+        constexpr static float  EQ_KERNEL_FLOOR     = 1e-6f; // -120 dB
+        constexpr static size_t EQ_PREROLL_BLOCKS   = 4;
+        constexpr static size_t EQ_PREROLL_SIZE     = EQ_PREROLL_BLOCKS * EQ_BUFFER_SIZE;
 
         //-------------------------------------------------------------------------
         // Plugin factory
@@ -46,57 +69,239 @@ namespace lsp
             {
                 const meta::plugin_t   *metadata;
                 uint8_t                 channels;
+                uint8_t                 filters;
                 uint8_t                 mode;
             } plugin_settings_t;
 
             static const meta::plugin_t *plugins[] =
             {
                 &meta::filter_mono,
-                &meta::filter_stereo
+                &meta::filter_stereo,
+                &meta::filter_x4_mono,
+                &meta::filter_x4_stereo,
+                &meta::filter_lr,
+                &meta::filter_ms,
+                &meta::filter_x8_multi,
+                &meta::filter_x16_multi
             };
 
             static const plugin_settings_t plugin_settings[] =
             {
-                { &meta::filter_mono,   1, filter::EQ_MONO         },
-                { &meta::filter_stereo, 1, filter::EQ_STEREO       },
-
-                { NULL, 0, false }
+                { &meta::filter_mono,       1,  1,                                  filter::EQ_MONO         },
+                { &meta::filter_stereo,     2,  1,                                  filter::EQ_STEREO       },
+                { &meta::filter_x4_mono,    1,  meta::filter_metadata::FILTERS_X4,  filter::EQ_MONO         },
+                { &meta::filter_x4_stereo,  2,  meta::filter_metadata::FILTERS_X4,  filter::EQ_STEREO       },
+                { &meta::filter_lr,         2,  1,                                  filter::EQ_LEFT_RIGHT   },
+                { &meta::filter_ms,         2,  1,                                  filter::EQ_MID_SIDE     },
+                { &meta::filter_x8_multi,   8,  1,                                  filter::EQ_MULTI        },
+                { &meta::filter_x16_multi,  16, 1,                                  filter::EQ_MULTI        },
+
+                { NULL, 0, 0, false }
             };
 
             static plug::Module *plugin_factory(const meta::plugin_t *meta)
             {
                 for (const plugin_settings_t *s = plugin_settings; s->metadata != NULL; ++s)
                     if (s->metadata == meta)
-                        return new filter(s->metadata, s->mode);
+                        return new filter(s->metadata, s->channels, s->filters, s->mode);
                 return NULL;
             }
 
-            static plug::Factory factory(plugin_factory, plugins, 2);
+            static plug::Factory factory(plugin_factory, plugins, 8);
+
+            //-------------------------------------------------------------------------
+            // Fused input and output stages: the gain, the Mid/Side conversion and the
+            // peak metering are done in a single pass over the block
+
+            // dst = src * k, returns the peak of dst, may be processed in place
+            static float scale_peak(float *dst, const float *src, float k, size_t count)
+            {
+                float peak      = 0.0f;
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float s   = src[i] * k;
+                    peak            = lsp_max(peak, fabsf(s));
+                    dst[i]          = s;
+                }
+                return peak;
+            }
+
+            // mid = (l + r) * k, side = (l - r) * k, stores the peaks of l*k and r*k
+            static void lr_to_ms_peak(float *mid, float *side, const float *l, const float *r, float k, float *peak, size_t count)
+            {
+                float pl        = 0.0f, pr = 0.0f;
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float sl  = l[i];
+                    const float sr  = r[i];
+                    pl              = lsp_max(pl, fabsf(sl));
+                    pr              = lsp_max(pr, fabsf(sr));
+                    mid[i]          = (sl + sr) * k;
+                    side[i]         = (sl - sr) * k;
+                }
+                peak[0]         = pl * k * 2.0f;
+                peak[1]         = pr * k * 2.0f;
+            }
+
+            // l = (mid + side) * kl, r = (mid - side) * kr, stores the peaks of l and r, may be processed in place
+            static void ms_to_lr_peak(float *l, float *r, const float *mid, const float *side, float kl, float kr, float *peak, size_t count)
+            {
+                float pl        = 0.0f, pr = 0.0f;
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float sm  = mid[i];
+                    const float ss  = side[i];
+                    const float sl  = (sm + ss) * kl;
+                    const float sr  = (sm - ss) * kr;
+                    pl              = lsp_max(pl, fabsf(sl));
+                    pr              = lsp_max(pr, fabsf(sr));
+                    l[i]            = sl;
+                    r[i]            = sr;
+                }
+                peak[0]         = pl;
+                peak[1]         = pr;
+            }
         } /* inline namespace */
 
         //-------------------------------------------------------------------------
-        filter::filter(const meta::plugin_t *metadata, size_t mode): plug::Module(metadata)
+        filter::AnalysisTask::AnalysisTask(filter *core)
+        {
+            pCore           = core;
+        }
+
+        filter::AnalysisTask::~AnalysisTask()
+        {
+            pCore           = NULL;
+        }
+
+        status_t filter::AnalysisTask::run()
+        {
+            pCore->process_analysis();
+            return STATUS_OK;
+        }
+
+        //-------------------------------------------------------------------------
+        filter::DesignTask::DesignTask(filter *core)
+        {
+            pCore           = core;
+        }
+
+        filter::DesignTask::~DesignTask()
+        {
+            pCore           = NULL;
+        }
+
+        status_t filter::DesignTask::run()
+        {
+            pCore->process_design();
+            return STATUS_OK;
+        }
+
+        //-------------------------------------------------------------------------
+        filter::filter(const meta::plugin_t *metadata, size_t channels, size_t filters, size_t mode):
+            plug::Module(metadata),
+            sAnalysisTask(this),
+            sDesignTask(this)
         {
             nMode           = mode;
+            nChannels       = channels;
+            nLinks          = ((mode == EQ_STEREO) || (mode == EQ_MULTI)) ? channels : 1;
+            nFilters        = filters;
             nDecramp        = 1;
+            nKernel         = KM_NONE;
+            nTailLength     = 0;
+            nResampler      = meta::filter_metadata::RESAMPLER_DFL;
+            nIdle           = 0;
+            nPrerollHead    = 0;
+            nIDisplay       = IDS_UNKNOWN;
+            nIDisplayQuery  = 0;
+            nIDisplayDraws  = 0;
+            nIDisplaySeen   = 0;
+            nKernelRank     = EQ_RANK;
+            sDesign.nRank       = EQ_RANK;
+            sDesign.nMode       = dspu::EQM_BYPASS;
+            sDesign.nKernel     = KM_NONE;
+            sDesign.nDecramp    = 1;
+            sDesign.nQuality    = meta::filter_metadata::RESAMPLER_DFL;
+            sDesign.fSampleRate = 0.0f;
+            sDesign.fEqRate     = 0.0f;
             vChannels       = NULL;
             vFreqs          = NULL;
             vBuffer         = NULL;
+            sKernel.vKernel     = NULL;
+            sKernel.vRe         = NULL;
+            sKernel.vIm         = NULL;
+            sKernel.vFreq       = NULL;
+            sKernel.vTr         = NULL;
+            sKernel.nRank       = 0;
+            sKernel.pData       = NULL;
             vIndexes        = NULL;
             fGainIn         = 1.0f;
             fZoom           = 1.0f;
-            bSmoothMode     = false;
+            fSmoothTime     = meta::filter_metadata::SMOOTH_TIME_DFL;
+
+            for (size_t i=0; i<4; ++i)
+            {
+                sAnalysis.vRing[i]      = NULL;
+                sAnalysis.vSpectrum[i]  = NULL;
+                sAnalysis.vEnable[i]    = false;
+            }
+            sAnalysis.nHead         = 0;
+            sAnalysis.nTail         = 0;
+            sAnalysis.nCount        = 0;
+            sAnalysis.nDelay        = 0;
+            sAnalysis.nRank         = meta::filter_metadata::FFT_RANK;
+            sAnalysis.nMaxRank      = 0;
+            sAnalysis.nChannels     = (mode == EQ_MULTI) ? 1 : channels;
+            sAnalysis.nSource       = 0;
+            sAnalysis.fReactivity   = 0.0f;
+            sAnalysis.fShift        = 1.0f;
+            sAnalysis.bActive       = false;
+            sAnalysis.bSync         = true;
+            sAnalysis.bRealloc      = false;
+
+            bProfile        = false;
+            bMeters         = true;
+            bUIActive       = false;
+            bIDisplayQuery  = false;
+            bIDisplayDirty  = false;
+            bVisual         = false;
+            bBypassed       = false;
+            bAutoDecramp    = false;
+            bIdle           = false;
+            for (size_t i=0; i<PS_TOTAL; ++i)
+            {
+                vStageTime[i]   = 0;
+                vStageLoad[i]   = 0.0f;
+            }
+            nLatency        = 0;
+            nMaxLatency     = 0;
+            for (size_t i=0; i<meta::filter_metadata::RESAMPLER_QUALITIES; ++i)
+                vResampleLatency[i] = 0;
+            for (size_t i=0; i<LS_TOTAL; ++i)
+                vStageLatency[i]    = 0;
             pIDisplay       = NULL;
 
             pBypass         = NULL;
             pGainIn         = NULL;
             pGainOut        = NULL;
             pReactivity     = NULL;
+            pFftRes         = NULL;
+            pFftChannel     = NULL;
             pShiftGain      = NULL;
             pZoom           = NULL;
             pEqMode         = NULL;
             pEqDecramp      = NULL;
+            pResampler      = NULL;
+            pSmooth         = NULL;
             pBalance        = NULL;
+            pMeters         = NULL;
+            pLatency        = NULL;
+            for (size_t i=0; i<LS_TOTAL; ++i)
+                pStageLatency[i]    = NULL;
+            pProfile        = NULL;
+            for (size_t i=0; i<PS_TOTAL; ++i)
+                pStageLoad[i]   = NULL;
         }
 
         filter::~filter()
@@ -387,6 +592,13 @@ namespace lsp
             return true;
         }
 
+        inline bool filter::is_identity(const dspu::filter_params_t *fp)
+        {
+            // Filters with adjustable gain are transparent at 0 dB
+            return (fp->nType == dspu::FLT_NONE) ||
+                ((adjust_gain(fp->nType)) && (fp->fGain == GAIN_AMP_0_DB));
+        }
+
         float   filter::calc_qfactor(float q, size_t type, size_t slope)
         {
             switch (type)
@@ -457,25 +669,43 @@ namespace lsp
                 case meta::filter_metadata::PEM_FIR: return dspu::EQM_FIR;
                 case meta::filter_metadata::PEM_FFT: return dspu::EQM_FFT;
                 case meta::filter_metadata::PEM_SPM: return dspu::EQM_SPM;
+                // Hybrid modes use the IIR equalizer to design the kernel
+                case meta::filter_metadata::PEM_HLP: return dspu::EQM_IIR;
+                case meta::filter_metadata::PEM_HMP: return dspu::EQM_IIR;
                 default:
                     break;
             }
             return dspu::EQM_BYPASS;
         }
 
+        inline uint32_t filter::get_kernel_mode(ssize_t mode)
+        {
+            switch (mode)
+            {
+                case meta::filter_metadata::PEM_HLP: return KM_LINEAR;
+                case meta::filter_metadata::PEM_HMP: return KM_MINIMUM;
+                default:
+                    break;
+            }
+            return KM_NONE;
+        }
+
         void filter::init(plug::IWrapper *wrapper, plug::IPort **ports)
         {
             // Pass wrapper
             plug::Module::init(wrapper, ports);
 
             // Determine number of channels
-            size_t channels     = (nMode == EQ_MONO) ? 1 : 2;
-            size_t max_latency  = 0;
+            const size_t channels       = nChannels;
+            const size_t an_channels    = sAnalysis.nChannels;
+            size_t max_latency          = 0;
 
             // Allocate channels
             vChannels           = new eq_channel_t[channels];
             if (vChannels == NULL)
                 return;
+            for (size_t i=0; i<channels; ++i)
+                vChannels[i].vFilters   = NULL;
 
             // Initialize global parameters
             fGainIn             = 1.0f;
@@ -491,10 +721,17 @@ namespace lsp
                 EQ_BUFFER_SIZE + // vBuffer
                 channels * (
                     EQ_BUFFER_SIZE + // vDryBuf
-                    EQ_BUFFER_SIZE + // vBuffer
-                    EQ_BUFFER_SIZE + // vAnalyzer
+                    EQ_BUFFER_SIZE + // vInBuffer
+                    EQ_BUFFER_SIZE + // vOutBuffer
+                    EQ_BUFFER_SIZE + // vOvsBuffer
+                    EQ_BUFFER_SIZE + // vXfBuffer
+                    EQ_PREROLL_SIZE + // vPreroll
                     2 * meta::filter_metadata::MESH_POINTS +    // vTr
                     meta::filter_metadata::MESH_POINTS          // vTrMem
+                ) +
+                an_channels * (
+                    2 * EQ_ANALYSIS_RING +                      // sAnalysis.vRing
+                    2 * meta::filter_metadata::MESH_POINTS      // sAnalysis.vSpectrum
                 );
             float *abuf         = new float[allocate];
             if (abuf == NULL)
@@ -508,60 +745,125 @@ namespace lsp
             vFreqs              = advance_ptr<float>(abuf, meta::filter_metadata::MESH_POINTS);
             vBuffer             = advance_ptr<float>(abuf, EQ_BUFFER_SIZE);
 
+            // Analysis buffers
+            for (size_t i=0; i<an_channels*2; ++i)
+            {
+                sAnalysis.vRing[i]      = advance_ptr<float>(abuf, EQ_ANALYSIS_RING);
+                sAnalysis.vSpectrum[i]  = advance_ptr<float>(abuf, meta::filter_metadata::MESH_POINTS);
+            }
+
             // Initialize each channel
             for (size_t i=0; i<channels; ++i)
             {
                 eq_channel_t *c     = &vChannels[i];
 
-                // Initialize oversampler
-                if (!c->sOversampler.init())
+                // Initialize the oversampler, the second one is used to switch the decramping
+                // smoothly and is allocated by the design task when it is needed first
+                if (!c->vOversampler[0].init())
+                    return;
+                c->vOversampler[0].set_filtering(false);
+                c->pOversampler     = &c->vOversampler[0];
+                c->pOvsNext         = &c->vOversampler[1];
+
+                // Initialize the equalizer, all filter slots share the same equalizer and oversampler.
+                // The second equalizer is used to design kernels in background and is allocated by
+                // the design task. The latency compensation should cover the longest kernel
+                dspu::Equalizer *eq = &c->vEqualizer[0];
+                if (!init_equalizer(eq, EQ_RANK_MAX))
+                    return;
+                max_latency         = lsp_max(max_latency,
+                    lsp_max(eq->max_latency(), EQ_KERNEL_SIZE / 2) + c->pOversampler->max_latency());
+                if (!init_equalizer(eq, EQ_RANK))
+                    return;
+                c->pEqualizer       = &c->vEqualizer[0];
+                c->pDesign          = &c->vEqualizer[1];
+                c->pConvolver       = &c->vConvolver[0];
+                c->pConvNext        = &c->vConvolver[1];
+                c->pAlign           = &c->vAlign[0];
+                c->pAlignNext       = &c->vAlign[1];
+
+                // Allocate filters
+                c->vFilters         = new eq_filter_t[nFilters];
+                if (c->vFilters == NULL)
                     return;
-                c->sOversampler.set_filtering(false);
-
-                // Initialize equalizer
-                c->sEqualizer.init(1, EQ_RANK);
-                c->sEqualizer.set_smooth(true);
-                max_latency         = lsp_max(max_latency, c->sEqualizer.max_latency() + c->sOversampler.max_latency());
 
                 // Init filter parameters
-                c->sOldFP.nType     = dspu::FLT_NONE;
-                c->sOldFP.fFreq     = 0.0f;
-                c->sOldFP.fFreq2    = 0.0f;
-                c->sOldFP.fGain     = GAIN_AMP_0_DB;
-                c->sOldFP.nSlope    = 0;
-                c->sOldFP.fQuality  = 0.0f;
-
-                c->sFP.nType        = dspu::FLT_NONE;
-                c->sFP.fFreq        = 0.0f;
-                c->sFP.fFreq2       = 0.0f;
-                c->sFP.fGain        = GAIN_AMP_0_DB;
-                c->sFP.nSlope       = 0;
-                c->sFP.fQuality     = 0.0f;
+                for (size_t j=0; j<nFilters; ++j)
+                {
+                    eq_filter_t *f      = &c->vFilters[j];
+
+                    f->sOldFP.nType     = dspu::FLT_NONE;
+                    f->sOldFP.fFreq     = 0.0f;
+                    f->sOldFP.fFreq2    = 0.0f;
+                    f->sOldFP.fGain     = GAIN_AMP_0_DB;
+                    f->sOldFP.nSlope    = 0;
+                    f->sOldFP.fQuality  = 0.0f;
+
+                    f->sFP.nType        = dspu::FLT_NONE;
+                    f->sFP.fFreq        = 0.0f;
+                    f->sFP.fFreq2       = 0.0f;
+                    f->sFP.fGain        = GAIN_AMP_0_DB;
+                    f->sFP.nSlope       = 0;
+                    f->sFP.fQuality     = 0.0f;
+
+                    f->sDesignFP        = f->sFP;
+                    f->sRamp.sCurr      = f->sFP;
+                    f->sRamp.fFreqK     = 1.0f;
+                    f->sRamp.fFreq2K    = 1.0f;
+                    f->sRamp.fGainK     = 1.0f;
+                    f->sRamp.fQualityD  = 0.0f;
+                    f->sRamp.nSteps     = 0;
+                    f->sRamp.nStepSize  = 0;
+                    f->sRamp.nOffset    = 0;
+
+                    f->pEnable          = NULL;
+                    f->pType            = NULL;
+                    f->pMode            = NULL;
+                    f->pFreq            = NULL;
+                    f->pWidth           = NULL;
+                    f->pSlope           = NULL;
+                    f->pGain            = NULL;
+                    f->pQuality         = NULL;
+                }
 
                 c->nLatency         = 0;
-                c->fInGain          = 1.0f;
+                c->nPad             = 0;
+                c->nDesignPad       = 0;
+                c->nDesignLatency   = 0;
                 c->fOutGain         = 1.0f;
                 c->vDryBuf          = advance_ptr<float>(abuf, EQ_BUFFER_SIZE);
                 c->vInBuffer        = advance_ptr<float>(abuf, EQ_BUFFER_SIZE);
                 c->vOutBuffer       = advance_ptr<float>(abuf, EQ_BUFFER_SIZE);
+                c->vOvsBuffer       = advance_ptr<float>(abuf, EQ_BUFFER_SIZE);
+                c->vXfBuffer        = advance_ptr<float>(abuf, EQ_BUFFER_SIZE);
+                c->vPreroll         = advance_ptr<float>(abuf, EQ_PREROLL_SIZE);
                 c->vIn              = NULL;
                 c->vOut             = NULL;
                 c->vInPtr           = NULL;
                 c->vTr              = advance_ptr<float>(abuf, meta::filter_metadata::MESH_POINTS * 2);
                 c->vTrMem           = advance_ptr<float>(abuf, meta::filter_metadata::MESH_POINTS);
                 c->nSync            = CS_UPDATE;
+                c->nDesign          = DS_NONE;
+                c->nXfOffset        = 0;
+                c->nXfLength        = 0;
+                c->nRank            = EQ_RANK;
+                c->nDesignRank      = 0;
+                c->nDecramp         = 1;
+                c->nDesignDecramp   = 1;
+                c->nKernel          = KM_NONE;
+                c->nDesignKernel    = KM_NONE;
+                c->bDesign          = false;
+                c->bRedesign        = false;
+                c->bOvsNext         = false;
+                c->bAlign           = false;
+                c->nIdentity        = IS_OFF;
+                c->nIdOffset        = 0;
+                c->nIdLength        = 0;
+                c->bIdentity        = false;
 
                 // Ports
-                c->pType            = NULL;
-                c->pMode            = NULL;
-                c->pFreq            = NULL;
-                c->pWidth           = NULL;
-                c->pGain            = NULL;
-                c->pQuality         = NULL;
-
                 c->pIn              = NULL;
                 c->pOut             = NULL;
-                c->pInGain          = NULL;
                 c->pTrAmp           = NULL;
                 c->pFftInSwitch     = NULL;
                 c->pFftOutSwitch    = NULL;
@@ -573,7 +875,9 @@ namespace lsp
 
             lsp_assert(abuf <= &save[allocate]);
 
-            // Initialize latency compensation delay
+            // Initialize latency compensation delay, the alignment delays of the equalizers
+            // are allocated by the design task when the equalizers are switched first
+            nMaxLatency         = uint32_t(max_latency);
             for (size_t i=0; i<channels; ++i)
             {
                 eq_channel_t *c     = &vChannels[i];
@@ -598,12 +902,15 @@ namespace lsp
             BIND_PORT(pGainOut);
             BIND_PORT(pEqMode);
             BIND_PORT(pEqDecramp);
+            BIND_PORT(pResampler);
+            BIND_PORT(pSmooth);
             BIND_PORT(pReactivity);
+            BIND_PORT(pFftRes);
             BIND_PORT(pShiftGain);
             BIND_PORT(pZoom);
 
-            // Meters
-            for (size_t i=0; i<channels; ++i)
+            // Analysis
+            for (size_t i=0; i<an_channels; ++i)
             {
                 eq_channel_t *c     = &vChannels[i];
 
@@ -613,13 +920,20 @@ namespace lsp
                 BIND_PORT(c->pFftOutMesh);
             }
 
+            if (nMode == EQ_MULTI)
+                BIND_PORT(pFftChannel);
+
             // Balance
-            if (channels > 1)
+            if ((channels > 1) && (nMode != EQ_MULTI))
                 BIND_PORT(pBalance);
 
+            // Meters
+            if (nMode == EQ_MULTI)
+                BIND_PORT(pMeters);
+
             for (size_t i=0; i<channels; ++i)
             {
-                if ((nMode == EQ_STEREO) && (i > 0))
+                if ((i % nLinks) > 0)
                     vChannels[i].pTrAmp     = NULL;
                 else
                     BIND_PORT(vChannels[i].pTrAmp);
@@ -631,40 +945,58 @@ namespace lsp
             // Bind filters
             lsp_trace("Binding filter ports");
 
-            for (size_t j=0; j<channels; ++j)
+            for (size_t k=0; k<nFilters; ++k)
             {
-                eq_channel_t *c     = &vChannels[j];
-
-                if ((nMode == EQ_STEREO) && (j > 0))
-                {
-                    // 1 port controls 2 filters
-                    eq_channel_t *sc    = &vChannels[0];
-                    c->pType            = sc->pType;
-                    c->pMode            = sc->pMode;
-                    c->pSlope           = sc->pSlope;
-                    c->pFreq            = sc->pFreq;
-                    c->pWidth           = sc->pWidth;
-                    c->pGain            = sc->pGain;
-                    c->pQuality         = sc->pQuality;
-                }
-                else
+                for (size_t j=0; j<channels; ++j)
                 {
-                    // 1 port controls 1 filter
-                    BIND_PORT(c->pType);
-                    BIND_PORT(c->pMode);
-                    BIND_PORT(c->pSlope);
-                    BIND_PORT(c->pFreq);
-                    BIND_PORT(c->pWidth);
-                    BIND_PORT(c->pGain);
-                    BIND_PORT(c->pQuality);
+                    eq_filter_t *f      = &vChannels[j].vFilters[k];
+
+                    if ((j % nLinks) > 0)
+                    {
+                        // 1 port controls filters of all linked channels
+                        eq_filter_t *sf     = &vChannels[0].vFilters[k];
+                        f->pEnable          = sf->pEnable;
+                        f->pType            = sf->pType;
+                        f->pMode            = sf->pMode;
+                        f->pSlope           = sf->pSlope;
+                        f->pFreq            = sf->pFreq;
+                        f->pWidth           = sf->pWidth;
+                        f->pGain            = sf->pGain;
+                        f->pQuality         = sf->pQuality;
+                    }
+                    else
+                    {
+                        // 1 port controls 1 filter, single-filter plugins have no enable switch
+                        if (nFilters > 1)
+                            BIND_PORT(f->pEnable);
+                        BIND_PORT(f->pType);
+                        BIND_PORT(f->pMode);
+                        BIND_PORT(f->pSlope);
+                        BIND_PORT(f->pFreq);
+                        BIND_PORT(f->pWidth);
+                        BIND_PORT(f->pGain);
+                        BIND_PORT(f->pQuality);
+                    }
                 }
             }
+
+            // Bind latency meters
+            lsp_trace("Binding latency meters");
+            BIND_PORT(pLatency);
+            for (size_t i=0; i<LS_TOTAL; ++i)
+                BIND_PORT(pStageLatency[i]);
+
+            // Bind DSP load meters
+            lsp_trace("Binding DSP load meters");
+            BIND_PORT(pProfile);
+            for (size_t i=0; i<PS_TOTAL; ++i)
+                BIND_PORT(pStageLoad[i]);
         }
 
         void filter::ui_activated()
         {
-            size_t channels     = ((nMode == EQ_MONO) || (nMode == EQ_STEREO)) ? 1 : 2;
-            for (size_t i=0; i<channels; ++i)
+            bUIActive           = true;
+            for (size_t i=0; i<nChannels; i += nLinks)
                 vChannels[i].nSync = CS_UPDATE;
 
             pWrapper->request_settings_update();
@@ -672,6 +1004,16 @@ namespace lsp
 
         void filter::ui_deactivated()
         {
+            bUIActive           = false;
+            pWrapper->request_settings_update();
+        }
+
+        void filter::deactivated()
+        {
+            // The inline display is detected again when the plugin is activated
+            nIDisplay           = IDS_UNKNOWN;
+            nIDisplayQuery      = 0;
+            bIDisplayQuery      = false;
             pWrapper->request_settings_update();
         }
 
@@ -683,13 +1025,32 @@ namespace lsp
 
         void filter::do_destroy()
         {
+            // Wait until the background tasks finish their job
+            wait_analysis();
+            wait_design();
+
             // Delete channels
             if (vChannels != NULL)
             {
+                for (size_t i=0; i<nChannels; ++i)
+                {
+                    eq_channel_t *c     = &vChannels[i];
+                    if (c->vFilters != NULL)
+                    {
+                        delete [] c->vFilters;
+                        c->vFilters         = NULL;
+                    }
+                    for (size_t j=0; j<2; ++j)
+                        c->vConvolver[j].destroy();
+                }
+
                 delete [] vChannels;
                 vChannels = NULL;
             }
 
+            // Delete kernel buffers
+            free_kernel(&sKernel);
+
             if (vIndexes != NULL)
             {
                 delete [] vIndexes;
@@ -728,6 +1089,8 @@ namespace lsp
                 case 3: exp         = 4; break;
                 case 4: exp         = 6; break;
                 case 5: exp         = 8; break;
+                // Automatic decramping is selected after the filter parameters are computed
+                case 6: return nDecramp;
                 default:exp         = 1; break;
             }
 
@@ -757,326 +1120,1808 @@ namespace lsp
             return 8;
         }
 
-        dspu::over_mode_t filter::calc_oversampler_mode(dspu::equalizer_mode_t eq_mode, size_t decramp)
-        {
-            if ((eq_mode != dspu::EQM_IIR) && (eq_mode != dspu::EQM_FIR))
-                return dspu::over_mode_t::OM_NONE;
-
-            switch (decramp)
-            {
-                case 2: return dspu::over_mode_t::OM_LANCZOS_2X16BIT;
-                case 3: return dspu::over_mode_t::OM_LANCZOS_3X16BIT;
-                case 4: return dspu::over_mode_t::OM_LANCZOS_4X16BIT;
-                case 6: return dspu::over_mode_t::OM_LANCZOS_6X16BIT;
-                case 8: return dspu::over_mode_t::OM_LANCZOS_8X16BIT;
-                default: break;
-            }
-            return dspu::over_mode_t::OM_NONE;
-        }
-
-        void filter::update_settings()
+        uint32_t filter::calc_auto_decramping(size_t decramp) const
         {
-            // Check sample rate
-            if (fSampleRate <= 0)
-                return;
+            static const uint32_t factors[] = { 1, 2, 3, 4, 6, 8 };
 
-            // Update common settings
-            if (pGainIn != NULL)
-                fGainIn     = pGainIn->value();
-            if (pZoom != NULL)
+            // Estimate the frequency warping of the bilinear transform at the upper edge of each filter,
+            // steep filters make the error of the magnitude response larger
+            for (size_t k=0; k<sizeof(factors)/sizeof(uint32_t); ++k)
             {
-                float zoom  = pZoom->value();
-                if (zoom != fZoom)
+                const float sample_rate = fSampleRate * factors[k];
+                float error             = 0.0f;
+                for (size_t i=0; i<nChannels; ++i)
                 {
-                    fZoom       = zoom;
-                    pWrapper->query_display_draw();
+                    const eq_channel_t *c   = &vChannels[i];
+                    for (size_t j=0; j<nFilters; ++j)
+                    {
+                        const dspu::filter_params_t *fp = &c->vFilters[j].sFP;
+                        if (fp->nType == dspu::FLT_NONE)
+                            continue;
+
+                        const float q       = lsp_max(fp->fQuality, EQ_DECRAMP_Q_MIN);
+                        const float f       = lsp_max(fp->fFreq, fp->fFreq2) * (1.0f + 1.0f / q);
+                        const float w       = lsp_min(M_PI * f / sample_rate, EQ_DECRAMP_W_MAX);
+                        error               = lsp_max(error, (tanf(w) / w - 1.0f) * lsp_max(size_t(fp->nSlope), size_t(1)));
+                    }
                 }
-            }
 
-            // Calculate balance
-            float bal[2] = { 1.0f, 1.0f };
-            if (pBalance != NULL)
-            {
-                float xbal      = pBalance->value();
-                bal[0]          = (100.0f - xbal) * 0.01f;
-                bal[1]          = (xbal + 100.0f) * 0.01f;
-            }
-            if (pGainOut != NULL)
-            {
-                float out_gain  = pGainOut->value();
-                bal[0]         *= out_gain;
-                bal[1]         *= out_gain;
+                // Lower oversampling is selected only when the error is noticeably smaller than
+                // the threshold, so the automation of the filter does not switch it back and forth
+                const float threshold   = (factors[k] < decramp) ? EQ_DECRAMP_ERROR * EQ_DECRAMP_HYST : EQ_DECRAMP_ERROR;
+                if (error <= threshold)
+                    return factors[k];
             }
 
+            return 8;
+        }
 
-            size_t channels     = (nMode == EQ_MONO) ? 1 : 2;
-
-            // Configure analyzer
-            size_t n_an_channels = 0;
-            for (size_t i=0; i<channels; ++i)
+        void filter::apply_decramping()
+        {
+            // Channels switch to the selected decramping by crossfading with the next equalizer
+            // designed in background, the active equalizer and oversampler keep playing meanwhile
+            for (size_t i=0; i<nChannels; ++i)
             {
                 eq_channel_t *c     = &vChannels[i];
-                bool in_fft         = c->pFftInSwitch->value() >= 0.5f;
-                bool out_fft        = c->pFftOutSwitch->value() >= 0.5f;
-
-                // channel:        0     1     2      3
-                // designation: in_l out_l  in_r  out_r
-                sAnalyzer.enable_channel(i*2, in_fft);
-                sAnalyzer.enable_channel(i*2+1, out_fft);
-                if ((in_fft) || (out_fft))
-                    ++n_an_channels;
-            }
-
-            // Update reactivity
-            sAnalyzer.set_activity(n_an_channels > 0);
-            sAnalyzer.set_reactivity(pReactivity->value());
-
-            // Update shift gain
-            if (pShiftGain != NULL)
-                sAnalyzer.set_shift(pShiftGain->value() * 100.0f);
-
-            // Update equalizer mode
-            dspu::equalizer_mode_t eq_mode  = get_eq_mode(pEqMode->value());
-            bool bypass                     = pBypass->value() >= 0.5f;
-            bool mode_changed               = false;
-            bool decramp_changed            = false;
-            bSmoothMode                     = false;
-            const uint32_t decramp          = calc_decramping();
-            const dspu::over_mode_t over_mode   = calc_oversampler_mode(eq_mode, decramp);
+                const bool idle     = (c->nDesign == DS_NONE) || (c->nDesign == DS_PENDING);
+                const uint32_t next = (idle) ? c->nDecramp : c->nDesignDecramp;
+                if (next == nDecramp)
+                    continue;
 
-            if (decramp != nDecramp)
-            {
-                nDecramp                        = decramp;
-                decramp_changed                 = true;
+                if (c->nDesign == DS_NONE)
+                    c->nDesign          = DS_PENDING;
+                else if (c->nDesign != DS_PENDING)
+                    c->bRedesign        = true;
             }
+        }
 
-            // For each channel
-            for (size_t i=0; i<channels; ++i)
+        dspu::over_mode_t filter::calc_oversampler_mode(dspu::equalizer_mode_t eq_mode, size_t kernel, size_t decramp, size_t quality)
+        {
+            // Resampler kernels ordered by quality: shorter kernels give lower latency and CPU load
+            static const dspu::over_mode_t modes[][5] =
             {
-                eq_channel_t *c     = &vChannels[i];
-
-                // Set-up sample rate
-                c->sOversampler.set_sample_rate(fSampleRate);
-                c->sOversampler.set_mode(over_mode);
-
-                if (c->sOversampler.modified())
                 {
-                    c->sOversampler.update_settings();
-                    decramp_changed     = true;
-                }
-
-                // Change the operating mode for the equalizer
-                if (c->sEqualizer.mode() != eq_mode)
+                    dspu::over_mode_t::OM_LANCZOS_2X2, dspu::over_mode_t::OM_LANCZOS_2X3,
+                    dspu::over_mode_t::OM_LANCZOS_2X12BIT, dspu::over_mode_t::OM_LANCZOS_2X16BIT,
+                    dspu::over_mode_t::OM_LANCZOS_2X24BIT
+                },
                 {
-                    c->sEqualizer.set_mode(eq_mode);
-                    mode_changed        = true;
-                }
-                c->sEqualizer.set_sample_rate(fSampleRate * nDecramp);
-                c->sEqualizer.set_actual_sample_rate(fSampleRate);
-
-                // Update settings
-                if (c->sBypass.set_bypass(bypass))
-                    pWrapper->query_display_draw();
-                c->fOutGain         = bal[i];
-                if (c->pInGain != NULL)
-                    c->fInGain          = c->pInGain->value();
-
-                // Update filter configuration
-                c->sOldFP           = c->sFP;
-                dspu::filter_params_t *fp = &c->sFP;
-                dspu::filter_params_t *op = &c->sOldFP;
-
-                // Compute filter params
-                fp->nType           = c->pType->value();
-                fp->nSlope          = decode_slope(c->pSlope->value());
-                decode_filter(&fp->nType, &fp->nSlope, c->pMode->value());
-
-                if (filter_has_width(fp->nType))
+                    dspu::over_mode_t::OM_LANCZOS_3X2, dspu::over_mode_t::OM_LANCZOS_3X3,
+                    dspu::over_mode_t::OM_LANCZOS_3X12BIT, dspu::over_mode_t::OM_LANCZOS_3X16BIT,
+                    dspu::over_mode_t::OM_LANCZOS_3X24BIT
+                },
                 {
-                    float center = c->pFreq->value();
-                    float k = powf(2, (c->pWidth->value()*0.5f));
-                    fp->fFreq           = center/k;
-                    fp->fFreq2          = center*k;
-                }
-                else
+                    dspu::over_mode_t::OM_LANCZOS_4X2, dspu::over_mode_t::OM_LANCZOS_4X3,
+                    dspu::over_mode_t::OM_LANCZOS_4X12BIT, dspu::over_mode_t::OM_LANCZOS_4X16BIT,
+                    dspu::over_mode_t::OM_LANCZOS_4X24BIT
+                },
                 {
-                    fp->fFreq           = c->pFreq->value();
-                    fp->fFreq2          = fp->fFreq;
-                }
-                fp->fGain           = (adjust_gain(fp->nType)) ? c->pGain->value() : 1.0f;
-                fp->fQuality        = calc_qfactor(c->pQuality->value(), fp->nType, fp->nSlope);
-
-                c->sEqualizer.limit_params(0, fp);
-                bool type_changed   =
-                    (fp->nType != op->nType) ||
-                    (fp->nSlope != op->nSlope);
-                bool param_changed  =
-                    (fp->fGain != op->fGain) ||
-                    (fp->fFreq != op->fFreq) ||
-                    (fp->fFreq2 != op->fFreq2) ||
-                    (fp->fQuality != op->fQuality);
-
-                // Apply filter params if theey have changed
-                if ((type_changed) || (param_changed) || (decramp_changed))
+                    dspu::over_mode_t::OM_LANCZOS_6X2, dspu::over_mode_t::OM_LANCZOS_6X3,
+                    dspu::over_mode_t::OM_LANCZOS_6X12BIT, dspu::over_mode_t::OM_LANCZOS_6X16BIT,
+                    dspu::over_mode_t::OM_LANCZOS_6X24BIT
+                },
                 {
-                    c->sEqualizer.set_params(0, fp);
-                    c->nSync            = CS_UPDATE;
+                    dspu::over_mode_t::OM_LANCZOS_8X2, dspu::over_mode_t::OM_LANCZOS_8X3,
+                    dspu::over_mode_t::OM_LANCZOS_8X12BIT, dspu::over_mode_t::OM_LANCZOS_8X16BIT,
+                    dspu::over_mode_t::OM_LANCZOS_8X24BIT
+                },
+            };
 
-                    if (type_changed)
-                        mode_changed    = true;
-                    if (param_changed)
-                        bSmoothMode     = true;
-                }
+            // Kernels of hybrid modes are designed from the decramped response and do not need oversampling
+            if (kernel != KM_NONE)
+                return dspu::over_mode_t::OM_NONE;
+            if ((eq_mode != dspu::EQM_IIR) && (eq_mode != dspu::EQM_FIR))
+                return dspu::over_mode_t::OM_NONE;
 
+            quality     = lsp_min(quality, 4u);
+            switch (decramp)
+            {
+                case 2: return modes[0][quality];
+                case 3: return modes[1][quality];
+                case 4: return modes[2][quality];
+                case 6: return modes[3][quality];
+                case 8: return modes[4][quality];
+                default: break;
             }
+            return dspu::over_mode_t::OM_NONE;
+        }
 
-            // Do not enable smooth mode if significant changes have been applied
-            if ((mode_changed) || (eq_mode != dspu::EQM_IIR))
-                bSmoothMode             = false;
+        void filter::calc_filter_params(eq_channel_t *c, size_t index)
+        {
+            eq_filter_t *f              = &c->vFilters[index];
+            dspu::filter_params_t *fp   = &f->sFP;
 
-            // Update analyzer
-            if (sAnalyzer.needs_reconfiguration())
+            // Disabled filter slot
+            if ((f->pEnable != NULL) && (f->pEnable->value() < 0.5f))
             {
-                sAnalyzer.reconfigure();
-                sAnalyzer.get_frequencies(vFreqs, vIndexes, SPEC_FREQ_MIN, SPEC_FREQ_MAX, meta::filter_metadata::MESH_POINTS);
+                fp->nType           = dspu::FLT_NONE;
+                fp->nSlope          = 0;
+                fp->fFreq           = 0.0f;
+                fp->fFreq2          = 0.0f;
+                fp->fGain           = GAIN_AMP_0_DB;
+                fp->fQuality        = 0.0f;
+                return;
             }
 
-            // Update latency
-            size_t latency          = 0;
-            for (size_t i=0; i<channels; ++i)
+            fp->nType           = f->pType->value();
+            fp->nSlope          = decode_slope(f->pSlope->value());
+            decode_filter(&fp->nType, &fp->nSlope, f->pMode->value());
+
+            if (filter_has_width(fp->nType))
             {
-                const float ovs_lat     = vChannels[i].sOversampler.latency();
-                const float eq_lat      = vChannels[i].sEqualizer.get_latency();
-                latency                 = lsp_max(latency, ovs_lat + eq_lat);
+                float center = f->pFreq->value();
+                float k = powf(2, (f->pWidth->value()*0.5f));
+                fp->fFreq           = center/k;
+                fp->fFreq2          = center*k;
             }
-
-            for (size_t i=0; i<channels; ++i)
+            else
             {
-                vChannels[i].sDryDelay.set_delay(latency);
-                sAnalyzer.set_channel_delay(i*2, latency);
+                fp->fFreq           = f->pFreq->value();
+                fp->fFreq2          = fp->fFreq;
             }
-            set_latency(latency);
+            fp->fGain           = (adjust_gain(fp->nType)) ? f->pGain->value() : 1.0f;
+            fp->fQuality        = calc_qfactor(f->pQuality->value(), fp->nType, fp->nSlope);
+
+            c->pEqualizer->limit_params(index, fp);
         }
 
-        void filter::update_sample_rate(long sr)
+        void filter::reset_ramp(eq_channel_t *c, size_t index, size_t links)
         {
-            size_t channels     = (nMode == EQ_MONO) ? 1 : 2;
-
-            sAnalyzer.set_sample_rate(sr);
-            size_t max_latency  = (1 << (meta::filter_metadata::FFT_RANK + 1)) + dspu::OVERSAMPLER_MAX_LATENCY;
+            const dspu::filter_params_t *fp = &c->vFilters[index].sFP;
 
-            // Initialize channels
-            for (size_t i=0; i<channels; ++i)
+            // Linked channels share the parameters of the first channel
+            for (size_t i=0; i<links; ++i)
             {
-                eq_channel_t *c     = &vChannels[i];
-                c->sBypass.init(sr);
+                eq_channel_t *lc    = &c[i];
+                filter_ramp_t *r    = &lc->vFilters[index].sRamp;
+
+                r->sCurr            = *fp;
+                r->nSteps           = 0;
+                r->nOffset          = 0;
+
+                lc->pEqualizer->set_params(index, &r->sCurr);
             }
+        }
 
-            // Initialize analyzer
-            if (!sAnalyzer.init(channels*2, meta::filter_metadata::FFT_RANK,
-                                sr, meta::filter_metadata::REFRESH_RATE,
-                                max_latency))
+        void filter::start_ramp(eq_channel_t *c, size_t index, size_t length, size_t links)
+        {
+            eq_filter_t *f                  = &c->vFilters[index];
+            filter_ramp_t *r                = &f->sRamp;
+            const dspu::filter_params_t *sp = &r->sCurr;
+            const dspu::filter_params_t *dp = &f->sFP;
+
+            // The ramp starts from currently applied parameters, they should be compatible with the target
+            const bool can_smooth   =
+                (length >= EQ_SMOOTH_STEP * 2) &&
+                (sp->nType == dp->nType) &&
+                (sp->nSlope == dp->nSlope) &&
+                (sp->fFreq > 0.0f) && (sp->fFreq2 > 0.0f) && (sp->fGain > 0.0f) &&
+                (dp->fFreq > 0.0f) && (dp->fFreq2 > 0.0f) && (dp->fGain > 0.0f);
+            if (!can_smooth)
+            {
+                reset_ramp(c, index, links);
                 return;
+            }
 
-            sAnalyzer.set_sample_rate(sr);
-            sAnalyzer.set_rank(meta::filter_metadata::FFT_RANK);
-            sAnalyzer.set_activity(false);
-            sAnalyzer.set_envelope(meta::filter_metadata::FFT_ENVELOPE);
-            sAnalyzer.set_window(meta::filter_metadata::FFT_WINDOW);
-            sAnalyzer.set_rate(meta::filter_metadata::REFRESH_RATE);
+            // Compute the increment for each design step once for the whole ramp. Ramps are applied only
+            // to recursive filters, steps of EQ_SMOOTH_STEP samples keep the transition free of zipper
+            // noise, long ramps are limited to EQ_SMOOTH_POINTS designs
+            const size_t steps  = lsp_min(length / EQ_SMOOTH_STEP, EQ_SMOOTH_POINTS);
+            const float k       = 1.0f / steps;
+
+            r->fFreqK           = expf(logf(dp->fFreq / sp->fFreq) * k);
+            r->fFreq2K          = expf(logf(dp->fFreq2 / sp->fFreq2) * k);
+            r->fGainK           = expf(logf(dp->fGain / sp->fGain) * k);
+            r->fQualityD        = (dp->fQuality - sp->fQuality) * k;
+            r->nSteps           = steps;
+            r->nStepSize        = length / steps;
+            r->nOffset          = 0;
         }
 
-        void filter::perform_analysis(size_t samples)
+        void filter::advance_ramp(eq_channel_t *c, size_t index, size_t links)
         {
-            // Do not do anything if analyzer is inactive
-            if (!sAnalyzer.activity())
-                return;
+            eq_filter_t *f      = &c->vFilters[index];
+            filter_ramp_t *r    = &f->sRamp;
 
-            // Prepare processing
-            size_t channels     = (nMode == EQ_MONO) ? 1 : 2;
+            if ((--r->nSteps) > 0)
+            {
+                r->sCurr.fFreq     *= r->fFreqK;
+                r->sCurr.fFreq2    *= r->fFreq2K;
+                r->sCurr.fGain     *= r->fGainK;
+                r->sCurr.fQuality  += r->fQualityD;
+            }
+            else
+                r->sCurr            = f->sFP;
 
-            const float *bufs[4] = { NULL, NULL, NULL, NULL };
-            for (size_t i=0; i<channels; ++i)
+            // Apply the same design to all linked channels
+            for (size_t i=0; i<links; ++i)
             {
-                eq_channel_t *c         = &vChannels[i];
-                bufs[i*2]               = c->vInPtr;
-                bufs[i*2+1]             = c->vOutBuffer;
+                eq_channel_t *lc    = &c[i];
+                lc->vFilters[index].sRamp.sCurr = r->sCurr;
+                lc->pEqualizer->set_params(index, &r->sCurr);
             }
+        }
 
-            // Perform FFT analysis
-            sAnalyzer.process(bufs, samples);
+        void filter::request_design(eq_channel_t *c, size_t index)
+        {
+            eq_filter_t *f      = &c->vFilters[index];
+            filter_ramp_t *r    = &f->sRamp;
+
+            // The active equalizer keeps playing until the new kernel is ready
+            r->sCurr            = f->sFP;
+            r->nSteps           = 0;
+            r->nOffset          = 0;
+
+            if (c->nDesign == DS_NONE)
+                c->nDesign          = DS_PENDING;
+            else if (c->nDesign != DS_PENDING)
+                c->bRedesign        = true;
         }
 
-        void filter::process_channel(eq_channel_t *c, size_t start, size_t samples, size_t total_samples)
+        void filter::process_design()
         {
-            const size_t oversampling   = c->sOversampler.get_oversampling();
-            const size_t ovs_count      = EQ_BUFFER_SIZE / oversampling;
+            // Computing the transfer function forces the equalizer to rebuild
+            // the kernel, so the audio thread gets the ready-to-use equalizer
+            float freq          = 1000.0f;
+            float tf[2];
 
-            // Process the signal by the equalizer
-            if (bSmoothMode)
+            for (size_t i=0; i<nChannels; i += nLinks)
             {
-                dspu::filter_params_t fp;
-                const float den   = 1.0f / total_samples;
+                // Linked channels share the filter settings, the kernel is designed once for the group
+                eq_channel_t *gc    = &vChannels[i];
+                size_t kernel_rank  = 0;
 
-                // In smooth mode, we need to update filter parameters for each sample
-                for (size_t offset=0; offset<samples; )
+                for (size_t j=0; j<nLinks; ++j)
                 {
-                    const size_t count          = lsp_min(samples - offset, EQ_SMOOTH_STEP);
-                    const float k               = float(start + offset) * den;
+                    eq_channel_t *c     = &gc[j];
+                    if (!c->bDesign)
+                        continue;
 
-                    // Tune the filter
-                    fp.nType                    = c->sFP.nType;
-                    fp.fFreq                    = c->sOldFP.fFreq * expf(logf(c->sFP.fFreq / c->sOldFP.fFreq)*k);
-                    fp.fFreq2                   = c->sOldFP.fFreq2 * expf(logf(c->sFP.fFreq2 / c->sOldFP.fFreq2)*k);
-                    fp.nSlope                   = c->sFP.nSlope;
-                    fp.fGain                    = c->sOldFP.fGain * expf(logf(c->sFP.fGain / c->sOldFP.fGain)*k);
-                    fp.fQuality                 = c->sOldFP.fQuality + (c->sFP.fQuality - c->sOldFP.fQuality)*k;
-
-                    c->sEqualizer.set_params(0, &fp);
+                    // The next oversampler and the alignment delays are allocated when the equalizers
+                    // are switched for the first time
+                    if (!c->bOvsNext)
+                    {
+                        if (!c->pOvsNext->init())
+                        {
+                            c->nDesignRank      = 0;
+                            continue;
+                        }
+                        c->pOvsNext->set_filtering(false);
+                        c->bOvsNext         = true;
+                    }
+                    if (!c->bAlign)
+                    {
+                        if ((!c->vAlign[0].init(nMaxLatency)) || (!c->vAlign[1].init(nMaxLatency)))
+                        {
+                            c->nDesignRank      = 0;
+                            continue;
+                        }
+                    }
 
-                    // Apply processing
-                    if (oversampling > 1)
+                    // The next equalizer is applied through the next oversampler, the output
+                    // of both equalizers is crossfaded at the sample rate of the host
+                    c->pOvsNext->set_sample_rate(sDesign.fSampleRate);
+                    c->pOvsNext->set_mode(calc_oversampler_mode(
+                        dspu::equalizer_mode_t(sDesign.nMode), sDesign.nKernel, sDesign.nDecramp, sDesign.nQuality));
+                    if (c->pOvsNext->modified())
+                        c->pOvsNext->update_settings();
+                    c->pOvsNext->reset();
+
+                    // Configure the next equalizer the same way as the active one, the length
+                    // of the kernel depends on the filter parameters. Re-allocation of the
+                    // equalizer is performed here to keep it out of the audio thread
+                    dspu::Equalizer *eq = c->pDesign;
+                    if (sDesign.nRank != c->nDesignRank)
                     {
-                        for (size_t j=0; j<count; )
+                        c->nDesignRank      = sDesign.nRank;
+                        if (!init_equalizer(eq, sDesign.nRank))
                         {
-                            const size_t to_do          = lsp_min(count - j, ovs_count);
-                            c->sOversampler.upsample(vBuffer, &c->vInPtr[offset + j], to_do);
-                            c->sEqualizer.process(vBuffer, vBuffer, to_do * oversampling);
-                            c->sOversampler.downsample(&c->vOutBuffer[offset + j], vBuffer, to_do);
-                            j                          += to_do;
+                            c->nDesignRank      = 0;
+                            continue;
                         }
                     }
-                    else
-                        c->sEqualizer.process(&c->vOutBuffer[offset], &c->vInPtr[offset], count);
-                    offset                     += count;
-                }
-            }
-            else
-            {
-                if (oversampling > 1)
-                {
-                    for (size_t j=0; j<samples; )
+                    eq->set_mode(dspu::equalizer_mode_t(sDesign.nMode));
+                    eq->set_sample_rate(sDesign.fEqRate);
+                    eq->set_actual_sample_rate(sDesign.fSampleRate);
+                    for (size_t k=0; k<nFilters; ++k)
+                        eq->set_params(k, &c->vFilters[k].sDesignFP);
+
+                    // Equalizers of other modes own their kernels and build them on their own
+                    if (sDesign.nKernel == KM_NONE)
+                    {
+                        eq->freq_chart(tf, &freq, 1);
+                        continue;
+                    }
+
+                    if (kernel_rank != c->nDesignRank)
                     {
-                        const size_t to_do          = lsp_min(samples - j, ovs_count);
-                        c->sOversampler.upsample(vBuffer, &c->vInPtr[j], to_do);
-                        c->sEqualizer.process(vBuffer, vBuffer, to_do * oversampling);
-                        c->sOversampler.downsample(&c->vOutBuffer[j], vBuffer, to_do);
-                        j                          += to_do;
+                        if (!alloc_kernel(&sKernel, c->nDesignRank))
+                        {
+                            c->nDesignRank      = 0;
+                            continue;
+                        }
+                        design_kernel(&sKernel, eq, sDesign.fSampleRate, c->nDesignRank, sDesign.nKernel, sDesign.nDecramp);
+                        kernel_rank         = c->nDesignRank;
                     }
+                    init_convolver(c->pConvNext, &sKernel, c->nDesignRank);
                 }
-                else
-                    c->sEqualizer.process(c->vOutBuffer, c->vInPtr, samples);
             }
-
-            if (c->fInGain != 1.0f)
-                dsp::mul_k2(c->vOutBuffer, c->fInGain, samples);
         }
 
-        void filter::process(size_t samples)
+        void filter::design_kernel(kernel_buf_t *kb, dspu::Equalizer *eq, float sample_rate, size_t rank, size_t kernel, size_t decramp)
         {
-            size_t channels     = (nMode == EQ_MONO) ? 1 : 2;
+            const size_t n      = size_t(1) << rank;
+            const size_t half   = n >> 1;
 
-            // Initialize buffer pointers
+            if ((kernel == KM_MINIMUM) && (decramp <= 1))
+            {
+                // The impulse response of the IIR equalizer is minimum-phase. Pass silence
+                // first to let the equalizer apply the smoothed parameters
+                eq->reset();
+                dsp::fill_zero(kb->vKernel, n);
+                eq->process(kb->vRe, kb->vKernel, n);
+                kb->vKernel[0]      = 1.0f;
+                eq->process(kb->vKernel, kb->vKernel, n);
+                eq->reset();
+
+                // Fade out the truncated tail of the impulse response
+                dsp::lramp1(&kb->vKernel[n - (n >> 3)], 1.0f, 0.0f, n >> 3);
+                return;
+            }
+
+            // Sample the magnitude of the transfer function at the FFT bins. The equalizer is designed
+            // at the decramped sample rate, so the magnitude is not cramped near the Nyquist frequency
+            const float kf      = sample_rate / float(n);
+            for (size_t i=0; i<=half; ++i)
+                kb->vFreq[i]        = i * kf;
+            eq->freq_chart(kb->vTr, kb->vFreq, half + 1);
+            dsp::pcomplex_mod(kb->vRe, kb->vTr, half + 1);
+
+            if (kernel == KM_MINIMUM)
+            {
+                // Compute the real cepstrum of the magnitude response
+                for (size_t i=0; i<=half; ++i)
+                    kb->vRe[i]          = logf(lsp_max(kb->vRe[i], EQ_KERNEL_FLOOR));
+                for (size_t i=1; i<half; ++i)
+                    kb->vRe[n - i]      = kb->vRe[i];
+                dsp::fill_zero(kb->vIm, n);
+                dsp::reverse_fft(kb->vTr, &kb->vTr[n], kb->vRe, kb->vIm, rank);
+
+                // Fold the cepstrum to make it causal, the exponent of its spectrum is minimum-phase
+                for (size_t i=1; i<half; ++i)
+                    kb->vTr[i]         *= 2.0f;
+                dsp::fill_zero(&kb->vTr[half + 1], half - 1);
+                dsp::fill_zero(&kb->vTr[n], n);
+                dsp::direct_fft(kb->vRe, kb->vIm, kb->vTr, &kb->vTr[n], rank);
+                for (size_t i=0; i<n; ++i)
+                {
+                    const float m       = expf(kb->vRe[i]);
+                    const float a       = kb->vIm[i];
+                    kb->vRe[i]          = m * cosf(a);
+                    kb->vIm[i]          = m * sinf(a);
+                }
+                dsp::reverse_fft(kb->vKernel, &kb->vTr[n], kb->vRe, kb->vIm, rank);
+
+                // Fade out the truncated tail of the impulse response
+                dsp::lramp1(&kb->vKernel[n - (n >> 3)], 1.0f, 0.0f, n >> 3);
+            }
+            else
+            {
+                // Build the real symmetric spectrum, the kernel becomes zero-phase
+                for (size_t i=1; i<half; ++i)
+                    kb->vRe[n - i]      = kb->vRe[i];
+                dsp::fill_zero(kb->vIm, n);
+                dsp::reverse_fft(kb->vTr, &kb->vTr[n], kb->vRe, kb->vIm, rank);
+
+                // Center the kernel to make it causal and apply the window
+                dsp::copy(kb->vKernel, &kb->vTr[half], half);
+                dsp::copy(&kb->vKernel[half], kb->vTr, half);
+                dspu::windows::window(kb->vRe, n, dspu::windows::BLACKMAN_HARRIS);
+                dsp::mul2(kb->vKernel, kb->vRe, n);
+            }
+        }
+
+        bool filter::alloc_kernel(kernel_buf_t *kb, size_t rank)
+        {
+            // The buffers are kept for the longest kernel designed so far
+            if (kb->nRank >= rank)
+                return true;
+
+            const size_t n      = size_t(1) << rank;
+            uint8_t *data       = NULL;
+            float *ptr          = alloc_aligned<float>(data, n * 6);
+            if (ptr == NULL)
+                return false;
+            free_kernel(kb);
+
+            kb->vKernel         = advance_ptr<float>(ptr, n);
+            kb->vRe             = advance_ptr<float>(ptr, n);
+            kb->vIm             = advance_ptr<float>(ptr, n);
+            kb->vFreq           = advance_ptr<float>(ptr, n);
+            kb->vTr             = advance_ptr<float>(ptr, n * 2);
+            kb->nRank           = uint32_t(rank);
+            kb->pData           = data;
+
+            return true;
+        }
+
+        void filter::free_kernel(kernel_buf_t *kb)
+        {
+            if (kb->pData != NULL)
+            {
+                free_aligned(kb->pData);
+                kb->pData           = NULL;
+            }
+            kb->vKernel         = NULL;
+            kb->vRe             = NULL;
+            kb->vIm             = NULL;
+            kb->vFreq           = NULL;
+            kb->vTr             = NULL;
+            kb->nRank           = 0;
+        }
+
+        void filter::init_convolver(dspu::Convolver *conv, const kernel_buf_t *kb, size_t rank)
+        {
+            conv->destroy();
+            conv->init(kb->vKernel, size_t(1) << rank, lsp_min(rank, EQ_CONV_RANK), 0.0f);
+        }
+
+        bool filter::init_equalizer(dspu::Equalizer *eq, size_t rank)
+        {
+            eq->destroy();
+            if (!eq->init(nFilters, rank))
+                return false;
+            eq->set_smooth(true);
+            return true;
+        }
+
+        float filter::estimate_decay(const eq_channel_t *c, float sample_rate) const
+        {
+            // Consider several periods of the lowest filter frequency,
+            // steep and narrow filters have longer impulse responses
+            float length        = 0.0f;
+            for (size_t j=0; j<nFilters; ++j)
+            {
+                const dspu::filter_params_t *fp = &c->vFilters[j].sFP;
+                if (fp->nType == dspu::FLT_NONE)
+                    continue;
+
+                const float periods = EQ_KERNEL_PERIODS * lsp_max(size_t(fp->nSlope), size_t(1)) *
+                    lsp_max(fp->fQuality, 1.0f);
+                length              = lsp_max(length, periods * sample_rate / lsp_max(fp->fFreq, 1.0f));
+            }
+
+            return length;
+        }
+
+        size_t filter::select_kernel_rank(size_t rank) const
+        {
+            // Fit the longest impulse response of the filters into the kernel
+            // Kernels of hybrid modes are applied without oversampling
+            const float kernel_rate = (nKernel != KM_NONE) ? fSampleRate : fSampleRate * nDecramp;
+            float length        = 0.0f;
+            for (size_t i=0; i<nChannels; ++i)
+                length              = lsp_max(length, estimate_decay(&vChannels[i], kernel_rate));
+            const size_t need   = (length <= 1.0f) ? EQ_RANK_MIN :
+                lsp_limit(size_t(ceilf(log2f(length))), EQ_RANK_MIN, EQ_RANK_MAX);
+
+            // Longer kernels are applied immediately to not truncate the impulse response. The kernel
+            // is shortened only when the response fits into a much shorter one, so sweeping the filter
+            // parameters does not make the latency jump back and forth
+            if ((need >= rank) || (need + EQ_RANK_HYSTERESIS <= rank))
+                return need;
+            return rank;
+        }
+
+        void filter::update_latency()
+        {
+            size_t latency          = 0;
+            size_t ovs_lat          = 0;
+            size_t eq_lat           = 0;
+            float decay             = 0.0f;
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                eq_channel_t *c         = &vChannels[i];
+                const size_t c_ovs      = c->pOversampler->latency();
+                const size_t c_eq       = equalizer_latency(c);
+
+                // The latency does not drop during the crossfade, the equalizer with lower latency is delayed
+                size_t c_lat            = reserve_latency(c_ovs + c_eq, c_ovs, c->pEqualizer->mode(), c->nKernel);
+                if (c->nDesign == DS_XFADE)
+                    c_lat                   = lsp_max(c_lat, size_t(c->nDesignLatency));
+
+                ovs_lat                 = lsp_max(ovs_lat, c_ovs);
+                eq_lat                  = lsp_max(eq_lat, c_eq);
+                latency                 = lsp_max(latency, c_lat);
+                decay                   = lsp_max(decay, estimate_decay(c, fSampleRate));
+            }
+
+            // Align the output of all equalizers to the reported latency
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                eq_channel_t *c         = &vChannels[i];
+                const size_t c_lat      = c->pOversampler->latency() + equalizer_latency(c);
+                size_t pad              = latency - c_lat;
+                if ((pad > 0) && (!c->bAlign))
+                {
+                    // The alignment delays are allocated by the design task
+                    pad                     = 0;
+                    if (c->nDesign == DS_NONE)
+                        c->nDesign              = DS_PENDING;
+                }
+                else if (c->nDesign == DS_WARMUP)
+                {
+                    // The alignment delays are filled during the warm-up, the new padding
+                    // is applied at the start of the crossfade
+                    c->nLatency             = uint32_t(c_lat + c->nPad);
+                    continue;
+                }
+                c->nPad                 = uint32_t(pad);
+                c->nLatency             = uint32_t(c_lat + pad);
+                if (!c->bAlign)
+                    continue;
+
+                c->pAlign->set_delay(pad);
+                if (c->nDesign == DS_XFADE)
+                {
+                    c->nDesignPad           = uint32_t(latency - path_latency(c->pOvsNext, c->pDesign, c->nDesignKernel, c->nDesignRank));
+                    c->pAlignNext->set_delay(c->nDesignPad);
+                }
+            }
+
+            vStageLatency[LS_OVERSAMPLER]   = uint32_t(ovs_lat);
+            vStageLatency[LS_EQUALIZER]     = uint32_t(eq_lat);
+
+            // The dry signal and the analysis are aligned to the same latency that is reported to the host
+            for (size_t i=0; i<nChannels; ++i)
+                vChannels[i].sDryDelay.set_delay(latency);
+            if (sAnalysis.nDelay != latency)
+            {
+                sAnalysis.nDelay        = uint32_t(latency);
+                sAnalysis.bSync         = true;
+            }
+            if (latency != nLatency)
+            {
+                nLatency                = uint32_t(latency);
+                set_latency(latency);
+            }
+
+            // The output decays after the delayed signal has passed the kernel and the filters have decayed,
+            // add the smoothing time to let the parameter transitions finish
+            nTailLength             = uint32_t(latency * 2 + decay + dspu::millis_to_samples(fSampleRate, fSmoothTime));
+        }
+
+        void filter::output_latency()
+        {
+            if (pLatency != NULL)
+                pLatency->set_value(dspu::samples_to_millis(fSampleRate, nLatency));
+            for (size_t i=0; i<LS_TOTAL; ++i)
+            {
+                if (pStageLatency[i] != NULL)
+                    pStageLatency[i]->set_value(dspu::samples_to_millis(fSampleRate, vStageLatency[i]));
+            }
+        }
+
+        bool filter::check_idle(size_t samples)
+        {
+            // Any signal at the input wakes up the processing
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                if (dsp::abs_max(vChannels[i].vIn, samples) > EQ_SILENCE_LEVEL)
+                {
+                    nIdle               = 0;
+                    return false;
+                }
+            }
+
+            // The background design should complete before the processing is suspended
+            bool idle           = nIdle >= nTailLength;
+            for (size_t i=0; i<nChannels; ++i)
+                idle                = idle && (vChannels[i].nDesign == DS_NONE);
+
+            nIdle               = lsp_min(nIdle + samples, size_t(nTailLength) + 1);
+            return idle;
+        }
+
+        size_t filter::equalizer_latency(eq_channel_t *c)
+        {
+            return path_latency(c->pOversampler, c->pEqualizer, c->nKernel, c->nRank) - c->pOversampler->latency();
+        }
+
+        size_t filter::path_latency(dspu::Oversampler *ovs, dspu::Equalizer *eq, size_t kernel, size_t rank)
+        {
+            // The kernel mode of the active convolver may differ from the selected one during the crossfade
+            switch (kernel)
+            {
+                case KM_LINEAR: return ovs->latency() + (size_t(1) << rank) / 2;
+                case KM_MINIMUM: return ovs->latency();
+                default:
+                    break;
+            }
+
+            // The equalizer runs at the oversampled rate, convert the latency to the samples of the host
+            const size_t oversampling   = lsp_max(ovs->get_oversampling(), size_t(1));
+            return ovs->latency() + (eq->get_latency() + oversampling / 2) / oversampling;
+        }
+
+        size_t filter::reserve_latency(size_t latency, size_t ovs_latency, dspu::equalizer_mode_t mode, size_t kernel) const
+        {
+            // Automatic decramping reserves the latency of the slowest resampler, so switching
+            // the oversampling does not change the latency reported to the host
+            if ((!bAutoDecramp) || (kernel != KM_NONE))
+                return latency;
+            if ((mode != dspu::EQM_IIR) && (mode != dspu::EQM_FIR))
+                return latency;
+
+            const size_t reserve        = vResampleLatency[lsp_min(size_t(nResampler), meta::filter_metadata::RESAMPLER_QUALITIES - 1)];
+            return latency - ovs_latency + lsp_max(ovs_latency, reserve);
+        }
+
+        void filter::start_warmup()
+        {
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                eq_channel_t *c     = &vChannels[i];
+                if (!c->bDesign)
+                    continue;
+                c->bDesign          = false;
+
+                // The design could be dropped by significant changes of settings
+                if (c->nDesign != DS_DESIGN)
+                    continue;
+
+                // The next equalizer could not be allocated, try again later
+                if (c->nDesignRank <= 0)
+                {
+                    c->nDesign          = DS_PENDING;
+                    continue;
+                }
+
+                // Fill the history of the new kernel, the recursive filters and the next
+                // oversampler with the input signal before crossfading
+                const size_t ovs_lat    = c->pOvsNext->latency();
+                const size_t length     = (c->nDesignKernel != KM_NONE) ?
+                    (size_t(1) << c->nDesignRank) :
+                    c->pDesign->get_latency() * 2;
+                c->nDesign          = DS_WARMUP;
+                c->nXfOffset        = 0;
+                c->nXfLength        = lsp_max(length, lsp_min(size_t(estimate_decay(c, fSampleRate)), EQ_KERNEL_SIZE)) + ovs_lat * 2;
+                const size_t next_lat   = path_latency(c->pOvsNext, c->pDesign, c->nDesignKernel, c->nDesignRank);
+                c->nDesignLatency   = uint32_t(reserve_latency(next_lat, ovs_lat, c->pDesign->mode(), c->nDesignKernel));
+
+                // The latency is raised at the start of the crossfade if the next equalizer has higher
+                // latency, the alignment delays of both equalizers should contain enough history by then
+                const size_t latency    = lsp_max(size_t(nLatency), size_t(c->nDesignLatency));
+                const size_t curr_lat   = path_latency(c->pOversampler, c->pEqualizer, c->nKernel, c->nRank);
+                c->nDesignPad       = uint32_t(latency - next_lat);
+                c->nXfLength       += lsp_max(size_t(c->nDesignPad), latency - lsp_min(latency, curr_lat));
+                c->pAlignNext->set_delay(c->nDesignPad);
+                if (!c->bAlign)
+                {
+                    c->pAlign->set_delay(c->nPad);
+                    c->bAlign           = true;
+                }
+                advance_design(c);
+            }
+        }
+
+        void filter::complete_design()
+        {
+            if (!sDesignTask.completed())
+                return;
+
+            sDesignTask.reset();
+            start_warmup();
+        }
+
+        void filter::submit_design()
+        {
+            // The next equalizers are owned by the design task while it is running
+            if (!sDesignTask.idle())
+                return;
+
+            size_t count        = 0;
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                eq_channel_t *c     = &vChannels[i];
+                if (c->nDesign != DS_PENDING)
+                    continue;
+
+                // Pass the snapshot of settings to the design task, the audio thread
+                // may change them while the design is in progress
+                sDesign.nRank       = nKernelRank;
+                sDesign.nMode       = get_eq_mode(pEqMode->value());
+                sDesign.nKernel     = nKernel;
+                sDesign.nDecramp    = nDecramp;
+                sDesign.nQuality    = nResampler;
+                sDesign.fSampleRate = fSampleRate;
+                sDesign.fEqRate     = fSampleRate * nDecramp;
+                for (size_t j=0; j<nFilters; ++j)
+                    c->vFilters[j].sDesignFP    = c->vFilters[j].sFP;
+
+                // The next equalizer is applied through the next oversampler which is configured
+                // by the design task, the oversampling may change with the decramping and the kernel mode
+                c->nDesignDecramp   = nDecramp;
+                c->nDesignKernel    = nKernel;
+
+                c->nDesign          = DS_DESIGN;
+                c->bDesign          = true;
+                ++count;
+            }
+            if (count <= 0)
+                return;
+
+            // Submit the task to the executor or design kernels in place if there is no executor
+            ipc::IExecutor *executor = pWrapper->executor();
+            if (executor != NULL)
+            {
+                if (executor->submit(&sDesignTask))
+                    return;
+
+                // Try again on the next block if the executor is busy
+                for (size_t i=0; i<nChannels; ++i)
+                {
+                    eq_channel_t *c     = &vChannels[i];
+                    if (!c->bDesign)
+                        continue;
+                    c->bDesign          = false;
+                    if (c->nDesign == DS_DESIGN)
+                        c->nDesign          = DS_PENDING;
+                }
+                return;
+            }
+
+            process_design();
+            start_warmup();
+        }
+
+        void filter::wait_design()
+        {
+            while (!sDesignTask.idle())
+            {
+                if (sDesignTask.completed())
+                    complete_design();
+                else
+                    ipc::Thread::sleep(1);
+            }
+        }
+
+        void filter::advance_design(eq_channel_t *c)
+        {
+            if (c->nXfOffset < c->nXfLength)
+                return;
+
+            if (c->nDesign == DS_WARMUP)
+            {
+                // The history is filled, crossfade over the smoothing time
+                c->nDesign          = DS_XFADE;
+                c->nXfOffset        = 0;
+                c->nXfLength        = lsp_max(dspu::millis_to_samples(fSampleRate, fSmoothTime), 1);
+
+                // Both equalizers are aligned to the same latency during the crossfade
+                update_latency();
+            }
+            else if (c->nDesign == DS_XFADE)
+            {
+                // The crossfade is over, the next equalizer with its oversampler becomes active
+                lsp::swap(c->pEqualizer, c->pDesign);
+                lsp::swap(c->pOversampler, c->pOvsNext);
+                lsp::swap(c->pAlign, c->pAlignNext);
+                lsp::swap(c->nRank, c->nDesignRank);
+                lsp::swap(c->nPad, c->nDesignPad);
+                c->nDecramp         = c->nDesignDecramp;
+                if (c->nDesignKernel != KM_NONE)
+                    lsp::swap(c->pConvolver, c->pConvNext);
+
+                // Parameter ramps of recursive filters were applied to the previous equalizer
+                if ((c->nDesignKernel == KM_NONE) && (c->pEqualizer->mode() == dspu::EQM_IIR))
+                {
+                    for (size_t j=0; j<nFilters; ++j)
+                        c->pEqualizer->set_params(j, &c->vFilters[j].sRamp.sCurr);
+                }
+                c->nKernel          = c->nDesignKernel;
+                c->nSync            = CS_UPDATE;
+                c->nDesign          = ((c->bRedesign) ||
+                                       (c->nRank != nKernelRank) ||
+                                       (c->nDecramp != nDecramp) ||
+                                       (c->nKernel != nKernel) ||
+                                       ((nKernel == KM_NONE) && (c->pEqualizer->mode() != get_eq_mode(pEqMode->value())))) ?
+                                       DS_PENDING : DS_NONE;
+                c->nXfOffset        = 0;
+                c->nXfLength        = 0;
+                c->bRedesign        = false;
+
+                // The latency follows the length of the new kernel, the alignment
+                // of the previous equalizer is not needed anymore
+                update_latency();
+            }
+        }
+
+        void filter::update_settings()
+        {
+            // Check sample rate
+            if (fSampleRate <= 0)
+                return;
+
+            // Update common settings
+            if (pGainIn != NULL)
+                fGainIn     = pGainIn->value();
+            if (pSmooth != NULL)
+                fSmoothTime = pSmooth->value();
+            bProfile    = (pProfile != NULL) && (pProfile->value() >= 0.5f);
+            bMeters     = (pMeters == NULL) || (pMeters->value() >= 0.5f);
+            bVisual     = (bUIActive) || (nIDisplay == IDS_SHOWN);
+            if (pZoom != NULL)
+            {
+                float zoom  = pZoom->value();
+                if (zoom != fZoom)
+                {
+                    fZoom           = zoom;
+                    bIDisplayDirty  = true;
+                }
+            }
+
+            // Calculate balance
+            float bal[2] = { 1.0f, 1.0f };
+            if (pBalance != NULL)
+            {
+                float xbal      = pBalance->value();
+                bal[0]          = (100.0f - xbal) * 0.01f;
+                bal[1]          = (xbal + 100.0f) * 0.01f;
+            }
+            if (pGainOut != NULL)
+            {
+                float out_gain  = pGainOut->value();
+                bal[0]         *= out_gain;
+                bal[1]         *= out_gain;
+            }
+
+            const size_t channels   = nChannels;
+
+            // Configure analyzer
+            size_t n_an_channels = 0;
+            if (pFftChannel != NULL)
+                sAnalysis.nSource       = lsp_limit(ssize_t(pFftChannel->value()) - 1, 0, ssize_t(channels) - 1);
+            for (size_t i=0; i<sAnalysis.nChannels; ++i)
+            {
+                eq_channel_t *c     = &vChannels[i];
+                bool in_fft         = c->pFftInSwitch->value() >= 0.5f;
+                bool out_fft        = c->pFftOutSwitch->value() >= 0.5f;
+
+                // channel:        0     1     2      3
+                // designation: in_l out_l  in_r  out_r
+                sAnalysis.vEnable[i*2]      = in_fft;
+                sAnalysis.vEnable[i*2+1]    = out_fft;
+                if ((in_fft) || (out_fft))
+                    ++n_an_channels;
+            }
+
+            // Update reactivity, the spectrum is shown only by the UI, the inline display draws the curve only
+            sAnalysis.bActive       = (n_an_channels > 0) && (bUIActive);
+            sAnalysis.fReactivity   = pReactivity->value();
+            sAnalysis.nRank         = select_fft_rank(size_t(pFftRes->value()), fSampleRate);
+
+            // Update shift gain
+            if (pShiftGain != NULL)
+                sAnalysis.fShift        = pShiftGain->value() * 100.0f;
+
+            // The analyzer is owned by the analysis task, settings are applied on the next submit
+            sAnalysis.bSync         = true;
+
+            // Update equalizer mode
+            dspu::equalizer_mode_t eq_mode  = get_eq_mode(pEqMode->value());
+            const uint32_t kernel           = get_kernel_mode(pEqMode->value());
+            const bool kernel_changed       = kernel != nKernel;
+            const bool kernel_switched      = (kernel_changed) && ((kernel == KM_NONE) || (nKernel == KM_NONE));
+            bool bypass                     = pBypass->value() >= 0.5f;
+            bool decramp_changed            = false;
+            const uint32_t decramp          = calc_decramping();
+            const size_t ramp_length        = dspu::millis_to_samples(fSampleRate, fSmoothTime);
+            nResampler                      = (pResampler != NULL) ? size_t(pResampler->value()) : meta::filter_metadata::RESAMPLER_DFL;
+
+            // The manually selected decramping is crossfaded by apply_decramping() like the automatic one
+            nDecramp                        = decramp;
+            nKernel                         = kernel;
+            bAutoDecramp                    = uint32_t(pEqDecramp->value()) == 6;
+            ipc::IExecutor *executor        = pWrapper->executor();
+
+            // For each channel
+            for (size_t i=0; i<channels; ++i)
+            {
+                eq_channel_t *c     = &vChannels[i];
+                bool eq_changed     = false;
+
+                // The active equalizer keeps playing with its own mode and oversampling until the equalizer
+                // of the new mode is designed in background and crossfaded with it
+                const bool switching    = (executor != NULL) &&
+                    ((kernel != c->nKernel) || ((kernel == KM_NONE) && (c->pEqualizer->mode() != eq_mode)));
+
+                // Set-up sample rate
+                c->pOversampler->set_sample_rate(fSampleRate);
+                if (!switching)
+                    c->pOversampler->set_mode(calc_oversampler_mode(eq_mode, kernel, c->nDecramp, nResampler));
+
+                if (c->pOversampler->modified())
+                {
+                    c->pOversampler->update_settings();
+                    decramp_changed     = true;
+                }
+
+                // Change the operating mode for the equalizer
+                if ((!switching) && (c->pEqualizer->mode() != eq_mode))
+                {
+                    c->pEqualizer->set_mode(eq_mode);
+                    eq_changed          = true;
+                }
+
+                // The design in progress is followed by the design of the new mode,
+                // without the executor the mode is switched immediately
+                if (switching)
+                {
+                    if (c->nDesign == DS_NONE)
+                        c->nDesign          = DS_PENDING;
+                }
+                else if ((kernel_switched) && (executor == NULL))
+                {
+                    c->nKernel          = KM_NONE;
+                    eq_changed          = true;
+                }
+                else if ((kernel_changed) && (c->nDesign == DS_NONE))
+                    c->nDesign          = DS_PENDING;
+
+                // Significant changes are applied immediately, drop the design in progress
+                if ((eq_changed) || (decramp_changed))
+                {
+                    c->nDesign          = DS_NONE;
+                    c->nXfOffset        = 0;
+                    c->nXfLength        = 0;
+                    c->bRedesign        = false;
+                }
+
+                // Without the executor the first kernel is designed in place with the selected decramping
+                if ((executor == NULL) && (kernel != KM_NONE) && (c->nKernel == KM_NONE))
+                    c->nDecramp         = nDecramp;
+                c->pEqualizer->set_sample_rate(fSampleRate * c->nDecramp);
+                c->pEqualizer->set_actual_sample_rate(fSampleRate);
+
+                // Update settings
+                if (c->sBypass.set_bypass(bypass))
+                    bIDisplayDirty      = true;
+                c->fOutGain         = (pBalance != NULL) ? bal[i] : bal[0];
+
+                // Update configuration of each filter slot
+                const bool linked   = (i % nLinks) > 0;
+                for (size_t j=0; j<nFilters; ++j)
+                {
+                    eq_filter_t *f      = &c->vFilters[j];
+                    const dspu::filter_params_t *fp = &f->sFP;
+                    const dspu::filter_params_t *op = &f->sOldFP;
+
+                    f->sOldFP           = f->sFP;
+                    if (linked)
+                    {
+                        // The filter has already been designed for the first channel, just share it
+                        f->sFP              = vChannels[0].vFilters[j].sFP;
+                    }
+                    else
+                        calc_filter_params(c, j);
+
+                    const bool type_changed     =
+                        (fp->nType != op->nType) ||
+                        (fp->nSlope != op->nSlope);
+                    const bool param_changed    =
+                        (fp->fGain != op->fGain) ||
+                        (fp->fFreq != op->fFreq) ||
+                        (fp->fFreq2 != op->fFreq2) ||
+                        (fp->fQuality != op->fQuality);
+
+                    // Apply filter params if theey have changed
+                    if ((type_changed) || (param_changed) || (decramp_changed) || (eq_changed))
+                    {
+                        c->nSync            = CS_UPDATE;
+
+                        // Smooth only parameter changes, significant changes should be applied immediately.
+                        // The ramp of linked channels is driven by the first channel. Kernels of non-IIR
+                        // modes and equalizers of the new mode are designed in background and crossfaded
+                        // with the current ones.
+                        if ((decramp_changed) || (eq_changed))
+                            reset_ramp(c, j, 1);
+                        else if ((switching) || (nKernel != KM_NONE) || ((eq_mode != dspu::EQM_IIR) && (eq_mode != dspu::EQM_BYPASS)))
+                            request_design(c, j);
+                        else if (type_changed)
+                            reset_ramp(c, j, 1);
+                        else if (!linked)
+                            start_ramp(c, j, ramp_length, lsp_min(size_t(nLinks), channels - i));
+                    }
+                }
+
+                // Detect the transparent filter settings to pass the signal without filtering
+                c->bIdentity        = true;
+                for (size_t j=0; j<nFilters; ++j)
+                    c->bIdentity        = (c->bIdentity) && (is_identity(&c->vFilters[j].sFP));
+            }
+
+            // Automatic decramping follows the filter settings, channels which do not match
+            // the selected decramping are switched smoothly
+            if (bAutoDecramp)
+                nDecramp                = calc_auto_decramping(nDecramp);
+            apply_decramping();
+
+            // Select the kernel length, all channels use the same length to keep them aligned.
+            // The kernel of the new length is designed in background and crossfaded with the
+            // current one, so the equalizers are never re-allocated in the audio thread
+            nKernelRank             = select_kernel_rank(nKernelRank);
+            size_t kernel_group     = channels;
+            size_t kernel_rank      = 0;
+            for (size_t i=0; i<channels; ++i)
+            {
+                eq_channel_t *c     = &vChannels[i];
+
+                if ((nKernel != KM_NONE) || ((eq_mode != dspu::EQM_IIR) && (eq_mode != dspu::EQM_BYPASS)))
+                {
+                    if ((nKernelRank != c->nRank) && (c->nDesign == DS_NONE))
+                        c->nDesign          = DS_PENDING;
+                }
+
+                // The first kernel of hybrid modes is designed in background while the equalizer keeps
+                // playing. Without the executor the kernel is designed in place once for the group
+                // of linked channels
+                if ((nKernel != KM_NONE) && (c->nKernel == KM_NONE))
+                {
+                    if (executor == NULL)
+                    {
+                        const size_t group      = i - (i % nLinks);
+                        if ((group != kernel_group) || (kernel_rank != c->nRank))
+                        {
+                            if (!alloc_kernel(&sKernel, c->nRank))
+                                continue;
+                            design_kernel(&sKernel, c->pEqualizer, fSampleRate, c->nRank, nKernel, c->nDecramp);
+                            kernel_group            = group;
+                            kernel_rank             = c->nRank;
+                        }
+                        init_convolver(c->pConvolver, &sKernel, c->nRank);
+                        c->nKernel          = nKernel;
+                    }
+                    else if (c->nDesign == DS_NONE)
+                        c->nDesign          = DS_PENDING;
+                }
+            }
+
+            update_latency();
+        }
+
+        size_t filter::select_fft_rank(size_t resolution, float sample_rate)
+        {
+            // Explicitly selected FFT size
+            if (resolution > 0)
+                return lsp_limit(meta::filter_metadata::FFT_RANK_MIN + resolution - 1,
+                    meta::filter_metadata::FFT_RANK_MIN, meta::filter_metadata::FFT_RANK_MAX);
+
+            // The frame should resolve the step of the mesh at the lowest plotted frequency, but
+            // the frame longer than a few refresh periods smears the changes the graph can show.
+            // The frame keeps its duration, so the FFT size grows with the sample rate up to the
+            // largest size available for the manual selection
+            const float step    = powf(meta::filter_metadata::FREQ_MAX / meta::filter_metadata::FREQ_MIN,
+                                    1.0f / (meta::filter_metadata::MESH_POINTS - 1)) - 1.0f;
+            const float time    = lsp_min(1.0f / (meta::filter_metadata::FREQ_MIN * step),
+                                    EQ_FFT_PERIODS / meta::filter_metadata::REFRESH_RATE);
+            const ssize_t rank  = log2f(time * sample_rate);
+
+            return lsp_limit(rank, ssize_t(meta::filter_metadata::FFT_RANK_MIN), ssize_t(meta::filter_metadata::FFT_RANK_MAX));
+        }
+
+        bool filter::init_analyzer()
+        {
+            size_t max_latency  = (1 << (sAnalysis.nMaxRank + 1)) + dspu::OVERSAMPLER_MAX_LATENCY;
+
+            // Allocate the analyzer buffers only for the selected FFT rank
+            if (!sAnalyzer.init(sAnalysis.nChannels*2, sAnalysis.nMaxRank,
+                                fSampleRate, meta::filter_metadata::REFRESH_RATE,
+                                max_latency))
+                return false;
+
+            sAnalyzer.set_sample_rate(fSampleRate);
+            sAnalyzer.set_rank(sAnalysis.nMaxRank);
+            sAnalyzer.set_activity(false);
+            sAnalyzer.set_envelope(meta::filter_metadata::FFT_ENVELOPE);
+            sAnalyzer.set_window(meta::filter_metadata::FFT_WINDOW);
+            sAnalyzer.set_rate(meta::filter_metadata::REFRESH_RATE);
+
+            return true;
+        }
+
+        void filter::update_sample_rate(long sr)
+        {
+            // Initialize channels, the background design is not valid anymore
+            wait_design();
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                eq_channel_t *c     = &vChannels[i];
+                c->sBypass.init(sr);
+                if (c->nKernel != KM_NONE)
+                {
+                    // The equalizer of hybrid modes plays until the kernel is designed again
+                    c->nKernel          = KM_NONE;
+                    c->nDecramp         = 1;
+                }
+                c->nDesign          = DS_NONE;
+                c->nXfOffset        = 0;
+                c->nXfLength        = 0;
+                c->bRedesign        = false;
+                c->nIdentity        = IS_OFF;
+                c->nIdOffset        = 0;
+                c->nIdLength        = 0;
+            }
+            nIdle               = 0;
+            bIdle               = false;
+
+            // Measure the longest latency of the decramping resampler of each quality
+            static const uint32_t factors[] = { 2, 3, 4, 6, 8 };
+            dspu::Oversampler ovs;
+            if (ovs.init())
+            {
+                ovs.set_sample_rate(sr);
+                for (size_t i=0; i<meta::filter_metadata::RESAMPLER_QUALITIES; ++i)
+                {
+                    size_t latency      = 0;
+                    for (size_t k=0; k<sizeof(factors)/sizeof(uint32_t); ++k)
+                    {
+                        ovs.set_mode(calc_oversampler_mode(dspu::EQM_IIR, KM_NONE, factors[k], i));
+                        if (ovs.modified())
+                            ovs.update_settings();
+                        latency             = lsp_max(latency, ovs.latency());
+                    }
+                    vResampleLatency[i] = uint32_t(latency);
+                }
+                ovs.destroy();
+            }
+
+            // The analyzer is going to be re-initialized, wait for the analysis task
+            wait_analysis();
+            sAnalysis.nTail     = sAnalysis.nHead;
+
+            // Initialize analyzer
+            sAnalysis.nRank     = select_fft_rank((pFftRes != NULL) ? size_t(pFftRes->value()) : 0, sr);
+            sAnalysis.nMaxRank  = sAnalysis.nRank;
+            sAnalysis.bRealloc  = false;
+            sAnalysis.bSync     = true;
+            init_analyzer();
+        }
+
+        void filter::perform_analysis(size_t samples)
+        {
+            // Do not do anything if analysis is inactive
+            if (!sAnalysis.bActive)
+                return;
+
+            // Drop samples if the analysis task does not keep up
+            const uint32_t used = sAnalysis.nHead - sAnalysis.nTail;
+            if ((used + samples) > EQ_ANALYSIS_RING)
+                return;
+
+            // Push input and output data of each channel to the ring
+            // channel:        0     1     2      3
+            // designation: in_l out_l  in_r  out_r
+            size_t head         = sAnalysis.nHead & (EQ_ANALYSIS_RING - 1);
+            size_t part         = lsp_min(samples, EQ_ANALYSIS_RING - head);
+
+            for (size_t i=0; i<sAnalysis.nChannels; ++i)
+            {
+                eq_channel_t *c         = &vChannels[sAnalysis.nSource + i];
+                float *in               = sAnalysis.vRing[i*2];
+                float *out              = sAnalysis.vRing[i*2+1];
+
+                dsp::copy(&in[head], c->vInPtr, part);
+                dsp::copy(&out[head], c->vOutBuffer, part);
+                if (part < samples)
+                {
+                    dsp::copy(in, &c->vInPtr[part], samples - part);
+                    dsp::copy(out, &c->vOutBuffer[part], samples - part);
+                }
+            }
+
+            sAnalysis.nHead    += samples;
+        }
+
+        void filter::process_analysis()
+        {
+            // Re-allocate the analyzer if the selected FFT rank does not fit
+            if (sAnalysis.bRealloc)
+            {
+                init_analyzer();
+                return;
+            }
+
+            const size_t channels   = sAnalysis.nChannels;
+            const float *bufs[4] = { NULL, NULL, NULL, NULL };
+            uint32_t tail       = sAnalysis.nTail;
+
+            // Perform FFT analysis of the submitted data
+            for (size_t count = sAnalysis.nCount; count > 0; )
+            {
+                size_t offset       = tail & (EQ_ANALYSIS_RING - 1);
+                size_t to_process   = lsp_min(count, EQ_ANALYSIS_RING - offset);
+
+                for (size_t i=0; i<channels*2; ++i)
+                    bufs[i]             = &sAnalysis.vRing[i][offset];
+                sAnalyzer.process(bufs, to_process);
+
+                tail               += to_process;
+                count              -= to_process;
+            }
+
+            // Publish spectrum data
+            for (size_t i=0; i<channels*2; ++i)
+            {
+                if (sAnalysis.vEnable[i])
+                    sAnalyzer.get_spectrum(i, sAnalysis.vSpectrum[i], vIndexes, meta::filter_metadata::MESH_POINTS);
+                else
+                    dsp::fill_zero(sAnalysis.vSpectrum[i], meta::filter_metadata::MESH_POINTS);
+            }
+        }
+
+        void filter::complete_analysis()
+        {
+            if (!sAnalysisTask.completed())
+                return;
+
+            // Release the processed part of the ring
+            sAnalysis.nTail    += sAnalysis.nCount;
+            sAnalysis.nCount    = 0;
+            sAnalysis.bRealloc  = false;
+            sAnalysisTask.reset();
+        }
+
+        void filter::submit_analysis()
+        {
+            // The analyzer is owned by the analysis task while it is running
+            if (!sAnalysisTask.idle())
+                return;
+
+            // Apply analyzer settings
+            if (sAnalysis.bSync)
+            {
+                // The analyzer should be re-allocated by the analysis task first,
+                // the settings will be applied after the task completes
+                if (sAnalysis.nRank > sAnalysis.nMaxRank)
+                {
+                    sAnalysis.nMaxRank  = sAnalysis.nRank;
+                    sAnalysis.nTail     = sAnalysis.nHead;
+                    sAnalysis.nCount    = 0;
+                    sAnalysis.bRealloc  = true;
+                    submit_analysis_task();
+                    return;
+                }
+
+                const size_t channels   = sAnalysis.nChannels;
+                for (size_t i=0; i<channels*2; ++i)
+                    sAnalyzer.enable_channel(i, sAnalysis.vEnable[i]);
+                for (size_t i=0; i<channels; ++i)
+                    sAnalyzer.set_channel_delay(i*2, sAnalysis.nDelay);
+                sAnalyzer.set_rank(sAnalysis.nRank);
+                sAnalyzer.set_activity(sAnalysis.bActive);
+                sAnalyzer.set_reactivity(sAnalysis.fReactivity);
+                sAnalyzer.set_shift(sAnalysis.fShift);
+
+                if (sAnalyzer.needs_reconfiguration())
+                {
+                    sAnalyzer.reconfigure();
+                    sAnalyzer.get_frequencies(vFreqs, vIndexes, SPEC_FREQ_MIN, SPEC_FREQ_MAX, meta::filter_metadata::MESH_POINTS);
+                }
+
+                sAnalysis.bSync     = false;
+            }
+
+            // Check that there is something to analyze
+            if (!sAnalysis.bActive)
+            {
+                sAnalysis.nTail     = sAnalysis.nHead;
+                return;
+            }
+            sAnalysis.nCount    = sAnalysis.nHead - sAnalysis.nTail;
+            if (sAnalysis.nCount == 0)
+                return;
+
+            submit_analysis_task();
+        }
+
+        void filter::submit_analysis_task()
+        {
+            // Submit the task to the executor or perform analysis in place if there is no executor
+            ipc::IExecutor *executor = pWrapper->executor();
+            if (executor != NULL)
+            {
+                // Try again on the next block if the executor is busy
+                if (!executor->submit(&sAnalysisTask))
+                    sAnalysis.nCount    = 0;
+                return;
+            }
+
+            process_analysis();
+            sAnalysis.nTail    += sAnalysis.nCount;
+            sAnalysis.nCount    = 0;
+            sAnalysis.bRealloc  = false;
+        }
+
+        void filter::wait_analysis()
+        {
+            while (!sAnalysisTask.idle())
+            {
+                if (sAnalysisTask.completed())
+                    complete_analysis();
+                else
+                    ipc::Thread::sleep(1);
+            }
+        }
+
+        inline uint64_t filter::profile_time()
+        {
+            // The wall clock may be adjusted while processing, use the monotonic one
+            const auto ts = std::chrono::steady_clock::now().time_since_epoch();
+            return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(ts).count());
+        }
+
+        inline uint64_t filter::profile_stage(size_t stage, uint64_t start)
+        {
+            if (!bProfile)
+                return 0;
+
+            const uint64_t time     = profile_time();
+            vStageTime[stage]      += time - start;
+            return time;
+        }
+
+        void filter::update_profile(size_t samples)
+        {
+            if (!bProfile)
+            {
+                for (size_t i=0; i<PS_TOTAL; ++i)
+                {
+                    vStageLoad[i]           = 0.0f;
+                    pStageLoad[i]->set_value(0.0f);
+                }
+                return;
+            }
+
+            // Compute the DSP load of each stage relative to the duration of the processed block
+            const double k          = (samples > 0) ? (100.0 * fSampleRate) / (1e+9 * samples) : 0.0;
+            for (size_t i=0; i<PS_TOTAL; ++i)
+            {
+                vStageLoad[i]           = vStageTime[i] * k;
+                pStageLoad[i]->set_value(vStageLoad[i]);
+            }
+        }
+
+        void filter::equalize(eq_channel_t *c, float *dst, const float *src, size_t count)
+        {
+            // The next equalizer is processed separately with its own oversampler
+            if (c->nKernel != KM_NONE)
+                c->pConvolver->process(dst, src, count);
+            else
+                c->pEqualizer->process(dst, src, count);
+        }
+
+        void filter::process_resample(eq_channel_t *c, size_t offset, size_t samples)
+        {
+            const bool hybrid           = c->nDesignKernel != KM_NONE;
+            const size_t oversampling   = c->pOvsNext->get_oversampling();
+            const size_t ovs_count      = EQ_BUFFER_SIZE / oversampling;
+
+            for (size_t done=0; done<samples; )
+            {
+                const size_t to_do          = lsp_min(samples - done, ovs_count);
+                const size_t ovs_to_do      = to_do * oversampling;
+                float *dst                  = &c->vOutBuffer[offset + done];
+
+                // Process the next equalizer at its own sample rate
+                if (oversampling > 1)
+                {
+                    c->pOvsNext->upsample(c->vOvsBuffer, &c->vInPtr[offset + done], to_do);
+                    if (hybrid)
+                        c->pConvNext->process(c->vOvsBuffer, c->vOvsBuffer, ovs_to_do);
+                    else
+                        c->pDesign->process(c->vOvsBuffer, c->vOvsBuffer, ovs_to_do);
+                    c->pOvsNext->downsample(c->vXfBuffer, c->vOvsBuffer, to_do);
+                }
+                else if (hybrid)
+                    c->pConvNext->process(c->vXfBuffer, &c->vInPtr[offset + done], to_do);
+                else
+                    c->pDesign->process(c->vXfBuffer, &c->vInPtr[offset + done], to_do);
+
+                // Both equalizers are aligned to the same latency, so they do not interfere
+                c->pAlignNext->process(c->vXfBuffer, c->vXfBuffer, to_do);
+
+                if (c->nDesign == DS_XFADE)
+                {
+                    // dst = dst + (next - dst) * k
+                    const float k       = 1.0f / c->nXfLength;
+                    dsp::sub2(c->vXfBuffer, dst, to_do);
+                    dsp::lramp_add2(dst, c->vXfBuffer, c->nXfOffset * k, (c->nXfOffset + to_do) * k, to_do);
+                }
+
+                c->nXfOffset       += to_do;
+                done               += to_do;
+            }
+        }
+
+        void filter::process_filters(eq_channel_t *gc, size_t links, size_t offset, size_t samples)
+        {
+            const size_t oversampling   = gc->pOversampler->get_oversampling();
+            uint64_t ts                 = (bProfile) ? profile_time() : 0;
+
+            if (oversampling <= 1)
+            {
+                for (size_t j=0; j<links; ++j)
+                {
+                    eq_channel_t *c             = &gc[j];
+                    equalize(c, &c->vOutBuffer[offset], &c->vInPtr[offset], samples);
+                }
+                ts                          = profile_stage(PS_EQUALIZER, ts);
+            }
+            else
+                ts                          = process_oversampled(gc, links, offset, samples, ts);
+
+            // Align the output to the reported latency and crossfade it with the next equalizer
+            bool xfade                  = false;
+            for (size_t j=0; j<links; ++j)
+            {
+                eq_channel_t *c             = &gc[j];
+                if (c->bAlign)
+                    c->pAlign->process(&c->vOutBuffer[offset], &c->vOutBuffer[offset], samples);
+                if ((c->nDesign == DS_WARMUP) || (c->nDesign == DS_XFADE))
+                {
+                    process_resample(c, offset, samples);
+                    xfade                       = true;
+                }
+            }
+            if (xfade)
+                profile_stage(PS_EQUALIZER, ts);
+        }
+
+        uint64_t filter::process_oversampled(eq_channel_t *gc, size_t links, size_t offset, size_t samples, uint64_t ts)
+        {
+            // Oversample all channels of the group chunk by chunk to keep the resampler
+            // kernels and the oversampled data hot in the cache
+            const size_t oversampling   = gc->pOversampler->get_oversampling();
+            const size_t ovs_count      = EQ_BUFFER_SIZE / oversampling;
+            for (size_t done=0; done<samples; )
+            {
+                const size_t to_do          = lsp_min(samples - done, ovs_count);
+                const size_t ovs_to_do      = to_do * oversampling;
+
+                for (size_t j=0; j<links; ++j)
+                {
+                    eq_channel_t *c             = &gc[j];
+                    c->pOversampler->upsample(c->vOvsBuffer, &c->vInPtr[offset + done], to_do);
+                }
+                ts                          = profile_stage(PS_OVERSAMPLER, ts);
+                for (size_t j=0; j<links; ++j)
+                {
+                    eq_channel_t *c             = &gc[j];
+                    equalize(c, c->vOvsBuffer, c->vOvsBuffer, ovs_to_do);
+                }
+                ts                          = profile_stage(PS_EQUALIZER, ts);
+                for (size_t j=0; j<links; ++j)
+                {
+                    eq_channel_t *c             = &gc[j];
+                    c->pOversampler->downsample(&c->vOutBuffer[offset + done], c->vOvsBuffer, to_do);
+                }
+                ts                          = profile_stage(PS_OVERSAMPLER, ts);
+
+                done                       += to_do;
+            }
+
+            return ts;
+        }
+
+        void filter::process_input(size_t samples)
+        {
+            if (nMode == EQ_MID_SIDE)
+            {
+                // Encode Mid/Side and apply the input gain in one pass
+                eq_channel_t *l = &vChannels[0], *r = &vChannels[1];
+                float peak[2];
+                lr_to_ms_peak(l->vInBuffer, r->vInBuffer, l->vIn, r->vIn, fGainIn * 0.5f, peak, samples);
+                l->vInPtr   = l->vInBuffer;
+                r->vInPtr   = r->vInBuffer;
+
+                l->pInMeter->set_value(peak[0]);
+                r->pInMeter->set_value(peak[1]);
+                return;
+            }
+
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                eq_channel_t *c = &vChannels[i];
+                float peak      = 0.0f;
+                if (fGainIn != 1.0f)
+                {
+                    // The gain and the metering are done in one pass
+                    peak        = scale_peak(c->vInBuffer, c->vIn, fGainIn, samples);
+                    c->vInPtr   = c->vInBuffer;
+                }
+                else
+                {
+                    // Metering of many channels is optional
+                    if (bMeters)
+                        peak        = dsp::abs_max(c->vIn, samples);
+                    c->vInPtr   = c->vIn;
+                }
+
+                c->pInMeter->set_value((bMeters) ? peak : 0.0f);
+            }
+        }
+
+        void filter::fade_out(size_t samples)
+        {
+            // The output pointers are already advanced, ramp the last block to zero before
+            // switching to silence, the remainder of the tail is below the silence level
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                float *out          = vChannels[i].vOut - samples;
+                dsp::lramp1(out, 1.0f, 0.0f, samples);
+            }
+        }
+
+        void filter::process_bypass(size_t samples)
+        {
+            // The pre-roll history is not valid anymore
+            if (!bBypassed)
+            {
+                for (size_t i=0; i<nChannels; ++i)
+                    dsp::fill_zero(vChannels[i].vPreroll, EQ_PREROLL_SIZE);
+                nPrerollHead        = 0;
+                bBypassed           = true;
+            }
+
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                eq_channel_t *c     = &vChannels[i];
+
+                // Keep the recent input to warm up the filters on release and meter it in the
+                // same pass. The output buffer may be the same as the input one, so do it before the delay
+                float peak          = 0.0f;
+                for (size_t done=0; done < samples; )
+                {
+                    const size_t head   = (nPrerollHead + done) % EQ_PREROLL_SIZE;
+                    const size_t count  = lsp_min(samples - done, EQ_PREROLL_SIZE - head);
+                    peak                = lsp_max(peak, scale_peak(&c->vPreroll[head], &c->vIn[done], 1.0f, count));
+                    done               += count;
+                }
+
+                // The wet signal is not computed, the output is the delayed input
+                c->pInMeter->set_value((bMeters) ? peak * fGainIn : 0.0f);
+                c->pOutMeter->set_value(0.0f);
+                c->sDryDelay.process(c->vOut, c->vIn, samples);
+
+                c->vIn             += samples;
+                c->vOut            += samples;
+            }
+            nPrerollHead        = (nPrerollHead + samples) % EQ_PREROLL_SIZE;
+        }
+
+        void filter::preroll(size_t offset)
+        {
+            // The history fills the resampler delay lines and the decaying tail of recursive filters.
+            // The replay is limited to a few blocks to keep the load of the release block low, the
+            // older state of long kernels is covered by the bypass crossfade
+            const size_t length = lsp_limit(size_t(nTailLength), EQ_BUFFER_SIZE, EQ_PREROLL_SIZE);
+
+            // Drop the stale state of the filters and pass the recent input through them,
+            // the output is not used
+            dsp::fill_zero(vBuffer, EQ_BUFFER_SIZE);
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                eq_channel_t *c     = &vChannels[i];
+                c->pOversampler->reset();
+                c->pEqualizer->reset();
+
+                // The convolver can not be reset, pass silence through it to drop the part
+                // of the history that is not overwritten by the replay
+                const size_t kernel = (c->nKernel != KM_NONE) ? size_t(1) << c->nRank : 0;
+                for (size_t flush = (kernel > length) ? kernel - length : 0; flush > 0; )
+                {
+                    const size_t count  = lsp_min(flush, EQ_BUFFER_SIZE);
+                    c->pConvolver->process(c->vXfBuffer, vBuffer, count);
+                    flush              -= count;
+                }
+            }
+
+            size_t tail         = (nPrerollHead + EQ_PREROLL_SIZE - length) % EQ_PREROLL_SIZE;
+            for (size_t done=0; done < length; )
+            {
+                const size_t count  = lsp_min(lsp_min(length - done, EQ_BUFFER_SIZE), EQ_PREROLL_SIZE - tail);
+                for (size_t i=0; i<nChannels; ++i)
+                    vChannels[i].vIn    = &vChannels[i].vPreroll[tail];
+
+                process_input(count);
+                for (size_t i=0; i<nChannels; i += nLinks)
+                    process_filters(&vChannels[i], nLinks, 0, count);
+
+                tail                = (tail + count) % EQ_PREROLL_SIZE;
+                done               += count;
+            }
+
+            // Restore the input of the current block
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                eq_channel_t *c     = &vChannels[i];
+                c->vIn              = c->pIn->buffer<float>() + offset;
+            }
+            bBypassed           = false;
+        }
+
+        void filter::process_identity(eq_channel_t *c, size_t offset, size_t samples)
+        {
+            // The dry buffer contains the input delayed by the latency of the filters
+            float *dst          = (c->nIdentity == IS_ON) ? &c->vOutBuffer[offset] : c->vXfBuffer;
+            if (nMode == EQ_MID_SIDE)
+            {
+                const eq_channel_t *l   = &vChannels[0], *r = &vChannels[1];
+                const float k           = fGainIn * 0.5f;
+                dsp::mix_copy2(dst, &l->vDryBuf[offset], &r->vDryBuf[offset], k, (c == l) ? k : -k, samples);
+            }
+            else
+                dsp::mul_k3(dst, &c->vDryBuf[offset], fGainIn, samples);
+
+            if (c->nIdentity == IS_WARMUP)
+                dsp::copy(&c->vOutBuffer[offset], dst, samples);
+            else if (c->nIdentity == IS_XFADE)
+            {
+                // out = identity + (filtered - identity) * k
+                const float k       = 1.0f / c->nIdLength;
+                float *out          = &c->vOutBuffer[offset];
+                dsp::sub2(out, dst, samples);
+                dsp::lramp1(out, c->nIdOffset * k, (c->nIdOffset + samples) * k, samples);
+                dsp::add2(out, dst, samples);
+            }
+        }
+
+        bool filter::update_identity(eq_channel_t *gc, size_t links)
+        {
+            // Linked channels share the filter settings, the first channel drives the group
+            if (gc->nIdentity == IS_OFF)
+            {
+                // Switch to the delayed input when all transitions of the filters are over
+                if (!gc->bIdentity)
+                    return false;
+                for (size_t j=0; j<nFilters; ++j)
+                    if (gc->vFilters[j].sRamp.nSteps > 0)
+                        return false;
+                for (size_t j=0; j<links; ++j)
+                    if (gc[j].nDesign != DS_NONE)
+                        return false;
+
+                for (size_t j=0; j<links; ++j)
+                    gc[j].nIdentity     = IS_ON;
+                return true;
+            }
+
+            if ((gc->nIdentity == IS_ON) && (!gc->bIdentity))
+            {
+                // The state of the filters is stale, restart them and fill with the input signal
+                // before crossfading to the filtered signal
+                const size_t length = (gc->nKernel != KM_NONE) ?
+                    (size_t(1) << gc->nRank) :
+                    gc->pEqualizer->get_latency() * 2;
+                for (size_t j=0; j<links; ++j)
+                {
+                    eq_channel_t *c     = &gc[j];
+                    c->pOversampler->reset();
+                    c->pEqualizer->reset();
+                    c->nIdentity        = IS_WARMUP;
+                    c->nIdOffset        = 0;
+                    c->nIdLength        = length + c->pOversampler->latency() + c->nPad;
+                }
+                advance_identity(gc, 0);
+                return false;
+            }
+            if (gc->nIdentity != IS_ON)
+                return false;
+
+            // The output does not depend on the filters, apply the designed kernels immediately
+            for (size_t j=0; j<links; ++j)
+            {
+                eq_channel_t *c     = &gc[j];
+                while ((c->nDesign == DS_WARMUP) || (c->nDesign == DS_XFADE))
+                {
+                    c->nXfOffset        = c->nXfLength;
+                    advance_design(c);
+                }
+            }
+
+            return true;
+        }
+
+        void filter::advance_identity(eq_channel_t *gc, size_t samples)
+        {
+            for (size_t j=0; j<nLinks; ++j)
+                gc[j].nIdOffset    += samples;
+            if (gc->nIdOffset < gc->nIdLength)
+                return;
+
+            const uint32_t state    = (gc->nIdentity == IS_WARMUP) ? IS_XFADE : IS_OFF;
+            const uint32_t length   = (state == IS_XFADE) ? lsp_max(dspu::millis_to_samples(fSampleRate, fSmoothTime), 1) : 0;
+            for (size_t j=0; j<nLinks; ++j)
+            {
+                eq_channel_t *c     = &gc[j];
+                c->nIdentity        = state;
+                c->nIdOffset        = 0;
+                c->nIdLength        = length;
+            }
+        }
+
+        void filter::process_channels(size_t samples)
+        {
+            const size_t channels       = nChannels;
+            const size_t links          = nLinks;
+
+            // Each group of linked channels shares the same ramps of the first channel in the group
+            for (size_t i=0; i<channels; i += links)
+            {
+                eq_channel_t *gc            = &vChannels[i];
+
+                // Transparent filters do not need any processing, pass the delayed input
+                if (update_identity(gc, links))
+                {
+                    for (size_t j=0; j<links; ++j)
+                        process_identity(&gc[j], 0, samples);
+                }
+
+                // Process the signal by the equalizer, active ramps split data into design steps
+                for (size_t offset=0; (offset<samples) && (gc->nIdentity != IS_ON); )
+                {
+                    size_t count                = samples - offset;
+                    for (size_t j=0; j<nFilters; ++j)
+                    {
+                        filter_ramp_t *r            = &gc->vFilters[j].sRamp;
+                        if (r->nSteps <= 0)
+                            continue;
+
+                        if (r->nOffset <= 0)
+                        {
+                            advance_ramp(gc, j, links);
+                            r->nOffset                  = (r->nSteps > 0) ? r->nStepSize : 0;
+                        }
+                        if (r->nOffset > 0)
+                            count                       = lsp_min(count, r->nOffset);
+                    }
+                    for (size_t j=0; j<links; ++j)
+                    {
+                        // Warm-up and crossfade of the next equalizer should not cross the block
+                        const eq_channel_t *c       = &gc[j];
+                        if ((c->nDesign == DS_WARMUP) || (c->nDesign == DS_XFADE))
+                            count                       = lsp_min(count, c->nXfLength - c->nXfOffset);
+                    }
+                    if (gc->nIdentity != IS_OFF)
+                        count                       = lsp_min(count, gc->nIdLength - gc->nIdOffset);
+                    for (size_t j=0; j<nFilters; ++j)
+                    {
+                        filter_ramp_t *r            = &gc->vFilters[j].sRamp;
+                        if (r->nOffset > 0)
+                            r->nOffset                 -= count;
+                    }
+
+                    process_filters(gc, links, offset, count);
+                    for (size_t j=0; j<links; ++j)
+                        advance_design(&gc[j]);
+                    if (gc->nIdentity != IS_OFF)
+                    {
+                        // Blend the filtered signal with the delayed input after leaving the identity state
+                        for (size_t j=0; j<links; ++j)
+                            process_identity(&gc[j], offset, count);
+                        advance_identity(gc, count);
+                    }
+                    offset                     += count;
+                }
+            }
+        }
+
+        void filter::process(size_t samples)
+        {
+            const size_t channels   = nChannels;
+
+            // Initialize buffer pointers
             for (size_t i=0; i<channels; ++i)
             {
                 eq_channel_t *c     = &vChannels[i];
@@ -1084,10 +2929,61 @@ namespace lsp
                 c->vOut             = c->pOut->buffer<float>();
             }
 
+            // Reset profiling data
+            for (size_t i=0; i<PS_TOTAL; ++i)
+                vStageTime[i]       = 0;
+
+            // Pick up the designed kernels and pass new filter parameters to the design task
+            complete_design();
+            submit_design();
+
             for (size_t offset = 0; offset < samples; )
             {
                 // Determine buffer size for processing
                 size_t to_process   = lsp_min(samples-offset, EQ_BUFFER_SIZE);
+                uint64_t ts         = (bProfile) ? profile_time() : 0;
+
+                // The input is silent and the tail has decayed: the last processed block
+                // has been faded out, output silence until the signal returns
+                const bool idle     = check_idle(to_process);
+                if ((idle) && (bIdle))
+                {
+                    for (size_t i=0; i<channels; ++i)
+                    {
+                        eq_channel_t *c     = &vChannels[i];
+                        dsp::fill_zero(c->vOut, to_process);
+                        c->pInMeter->set_value(0.0f);
+                        c->pOutMeter->set_value(0.0f);
+
+                        c->vIn             += to_process;
+                        c->vOut            += to_process;
+                    }
+                    profile_stage(PS_INPUT, ts);
+
+                    offset             += to_process;
+                    continue;
+                }
+
+                // Fully bypassed: only the dry delay is needed, the filters are warmed up on release
+                bool bypassed       = true;
+                for (size_t i=0; i<channels; ++i)
+                {
+                    const eq_channel_t *c   = &vChannels[i];
+                    bypassed            = (bypassed) && (c->sBypass.bypassing()) && (c->nDesign == DS_NONE);
+                }
+                if (bypassed)
+                {
+                    process_bypass(to_process);
+                    if (idle)
+                        fade_out(to_process);
+                    bIdle               = idle;
+                    profile_stage(PS_OUTPUT, ts);
+
+                    offset             += to_process;
+                    continue;
+                }
+                if (bBypassed)
+                    preroll(offset);
 
                 // Store unprocessed data
                 for (size_t i=0; i<channels; ++i)
@@ -1095,80 +2991,84 @@ namespace lsp
                     eq_channel_t *c     = &vChannels[i];
                     c->sDryDelay.process(c->vDryBuf, c->vIn, to_process);
                 }
+                ts                  = profile_stage(PS_DRY_DELAY, ts);
 
-                if (nMode == EQ_MONO)
-                {
-                    eq_channel_t *c = &vChannels[0];
-                    if (fGainIn != 1.0f)
-                    {
-                        dsp::mul_k3(c->vInBuffer, c->vIn, fGainIn, to_process);
-                        c->vInPtr = c->vInBuffer;
-                    }
-                    else
-                        c->vInPtr = c->vIn;
+                process_input(to_process);
+                profile_stage(PS_INPUT, ts);
+
+                // Process channels
+                process_channels(to_process);
+
+                // Call analyzer
+                ts                  = (bProfile) ? profile_time() : 0;
+                perform_analysis(to_process);
+                ts                  = profile_stage(PS_ANALYZER, ts);
 
-                    c->pInMeter->set_value(dsp::abs_max(c->vInPtr, to_process));
+                // Decode Mid/Side back to Left/Right, apply the output gain and do output metering in one pass
+                if (nMode == EQ_MID_SIDE)
+                {
+                    eq_channel_t *l = &vChannels[0], *r = &vChannels[1];
+                    float peak[2];
+                    ms_to_lr_peak(l->vOutBuffer, r->vOutBuffer, l->vOutBuffer, r->vOutBuffer, l->fOutGain, r->fOutGain, peak, to_process);
+                    l->pOutMeter->set_value((bMeters) ? peak[0] : 0.0f);
+                    r->pOutMeter->set_value((bMeters) ? peak[1] : 0.0f);
                 }
                 else
                 {
-                    eq_channel_t *l = &vChannels[0], *r = &vChannels[1];
-                    if (fGainIn != 1.0f)
+                    for (size_t i=0; i<channels; ++i)
                     {
-                        dsp::mul_k3(l->vInBuffer, l->vIn, fGainIn, to_process);
-                        dsp::mul_k3(r->vInBuffer, r->vIn, fGainIn, to_process);
-                        l->vInPtr   = l->vInBuffer;
-                        r->vInPtr   = r->vInBuffer;
+                        eq_channel_t *c     = &vChannels[i];
+                        float peak          = 0.0f;
+                        if (c->fOutGain != 1.0f)
+                            peak                = scale_peak(c->vOutBuffer, c->vOutBuffer, c->fOutGain, to_process);
+                        else if (bMeters)
+                            peak                = dsp::abs_max(c->vOutBuffer, to_process);
+                        c->pOutMeter->set_value((bMeters) ? peak : 0.0f);
                     }
-                    else
-                    {
-                        l->vInPtr   = l->vIn;
-                        r->vInPtr   = r->vIn;
-                    }
-
-                    l->pInMeter->set_value(dsp::abs_max(l->vInPtr, to_process));
-                    r->pInMeter->set_value(dsp::abs_max(r->vInPtr, to_process));
                 }
 
-                // Process each channel individually
-                for (size_t i=0; i<channels; ++i)
-                    process_channel(&vChannels[i], offset, to_process, samples);
-
-                // Call analyzer
-                perform_analysis(to_process);
-
-                // Process data via bypass
+                // Process data via bypass, the output gain is already applied
                 for (size_t i=0; i<channels; ++i)
                 {
                     eq_channel_t *c     = &vChannels[i];
-
-                    // Do output metering
-                    if (c->pOutMeter != NULL)
-                        c->pOutMeter->set_value(dsp::abs_max(c->vOutBuffer, to_process) * c->fOutGain);
-
-                    // Process via bypass
-                    if (c->fOutGain != 1.0f)
-                        c->sBypass.process_wet(c->vOut, c->vDryBuf, c->vOutBuffer, c->fOutGain, to_process);
-                    else
-                        c->sBypass.process(c->vOut, c->vDryBuf, c->vOutBuffer, to_process);
+                    c->sBypass.process(c->vOut, c->vDryBuf, c->vOutBuffer, to_process);
 
                     c->vIn             += to_process;
                     c->vOut            += to_process;
                 }
+                if (idle)
+                    fade_out(to_process);
+                bIdle               = idle;
+                profile_stage(PS_OUTPUT, ts);
 
                 // Update offset
                 offset             += to_process;
             } // for offset
 
-            // Output FFT curves for each channel and report latency
-            size_t latency          = 0;
+            // Report DSP load
+            update_profile(samples);
 
-            for (size_t i=0; i<channels; ++i)
+            // Report latency
+            output_latency();
+
+            // Nobody is watching: leave pending mesh updates until the UI appears
+            complete_analysis();
+            if (bVisual)
+                output_meshes();
+            update_inline_display(samples);
+
+            // Pass new data to the analysis task
+            submit_analysis();
+        }
+
+        void filter::output_meshes()
+        {
+            // Output FFT curves for each channel, the spectrum data is owned
+            // by the analysis task while it is running
+            for (size_t i=0; (i<sAnalysis.nChannels) && (bUIActive) && (sAnalysisTask.idle()); ++i)
             {
                 eq_channel_t *c     = &vChannels[i];
 
-                if (latency < c->sEqualizer.get_latency())
-                    latency         = c->sEqualizer.get_latency();
-
                 // Input FFT mesh
                 plug::mesh_t *mesh          = c->pFftInMesh->buffer<plug::mesh_t>();
                 if ((mesh != NULL) && (mesh->isEmpty()))
@@ -1181,7 +3081,7 @@ namespace lsp
 
                     // Copy frequency points
                     dsp::copy(&mesh->pvData[0][1], vFreqs, meta::filter_metadata::MESH_POINTS);
-                    sAnalyzer.get_spectrum(i*2, &mesh->pvData[1][1], vIndexes, meta::filter_metadata::MESH_POINTS);
+                    dsp::copy(&mesh->pvData[1][1], sAnalysis.vSpectrum[i*2], meta::filter_metadata::MESH_POINTS);
 
                     // Mark mesh containing data
                     mesh->data(2, meta::filter_metadata::MESH_POINTS+2);
@@ -1193,21 +3093,15 @@ namespace lsp
                 {
                     // Copy frequency points
                     dsp::copy(mesh->pvData[0], vFreqs, meta::filter_metadata::MESH_POINTS);
-                    sAnalyzer.get_spectrum(i*2+1, mesh->pvData[1], vIndexes, meta::filter_metadata::MESH_POINTS);
+                    dsp::copy(mesh->pvData[1], sAnalysis.vSpectrum[i*2+1], meta::filter_metadata::MESH_POINTS);
 
                     // Mark mesh containing data
                     mesh->data(2, meta::filter_metadata::MESH_POINTS);
                 }
             }
 
-            set_latency(latency);
-
-            // For Mono and Stereo channels only the first channel should be processed
-            if (nMode == EQ_STEREO)
-                channels        = 1;
-
-            // Sync meshes
-            for (size_t i=0; i<channels; ++i)
+            // For linked channels only the first channel should be processed
+            for (size_t i=0; i<nChannels; i += nLinks)
             {
                 eq_channel_t *c     = &vChannels[i];
                 if (c->pTrAmp == NULL)
@@ -1216,9 +3110,10 @@ namespace lsp
                 // Synchronize main transfer function of the channel
                 if (c->nSync & CS_UPDATE)
                 {
-                    c->sEqualizer.freq_chart(c->vTr, vFreqs, meta::filter_metadata::MESH_POINTS);
+                    c->pEqualizer->freq_chart(c->vTr, vFreqs, meta::filter_metadata::MESH_POINTS);
                     dsp::pcomplex_mod(c->vTrMem, c->vTr, meta::filter_metadata::MESH_POINTS);
-                    c->nSync    = CS_SYNC_AMP;
+                    c->nSync        = CS_SYNC_AMP;
+                    bIDisplayDirty  = true;
                 }
 
                 // Output amplification curve
@@ -1251,29 +3146,64 @@ namespace lsp
 
                         c->nSync           &= ~CS_SYNC_AMP;
                     }
-
-                    // Request for redraw
-                    if (pWrapper != NULL)
-                        pWrapper->query_display_draw();
                 }
             }
+        }
 
-            // Reset smooth mode
-            if (bSmoothMode)
+        void filter::update_inline_display(size_t samples)
+        {
+            // Pick up the draws performed by the host in the UI thread
+            const uatomic_t draws   = atomic_load(&nIDisplayDraws);
+            if (draws != nIDisplaySeen)
             {
-                // Apply actual settings of equalizer at the end
-                for (size_t i=0; i<channels; ++i)
+                nIDisplaySeen           = draws;
+                bIDisplayQuery          = false;
+                if (nIDisplay != IDS_SHOWN)
                 {
-                    eq_channel_t *c     = &vChannels[i];
-                    c->sEqualizer.set_params(0, &c->sFP);
+                    nIDisplay               = IDS_SHOWN;
+                    pWrapper->request_settings_update();
                 }
+            }
+
+            // The hidden inline display is probed again from time to time, the host may show it later
+            const size_t timeout    = dspu::seconds_to_samples(fSampleRate, EQ_IDISPLAY_TIMEOUT);
+            if ((!bIDisplayQuery) && (nIDisplay == IDS_HIDDEN))
+            {
+                nIDisplayQuery          = lsp_min(nIDisplayQuery + samples, timeout);
+                if (nIDisplayQuery < timeout)
+                    return;
+            }
 
-                bSmoothMode     = false;
+            // Hosts draw the inline display only on request: request the draw when the curve has changed,
+            // or to detect the inline display when its presence is unknown
+            if ((!bIDisplayQuery) && ((nIDisplay != IDS_SHOWN) || (bIDisplayDirty)))
+            {
+                nIDisplayQuery          = 0;
+                bIDisplayQuery          = true;
+                bIDisplayDirty          = false;
+                pWrapper->query_display_draw();
+                return;
             }
+            if (!bIDisplayQuery)
+                return;
+
+            // The request has not been answered for a while: the inline display is hidden
+            nIDisplayQuery          = lsp_min(nIDisplayQuery + samples, timeout);
+            if (nIDisplayQuery < timeout)
+                return;
+
+            nIDisplayQuery          = 0;
+            bIDisplayQuery          = false;
+            if (nIDisplay == IDS_SHOWN)
+                pWrapper->request_settings_update();
+            nIDisplay               = IDS_HIDDEN;
         }
 
         bool filter::inline_display(plug::ICanvas *cv, size_t width, size_t height)
         {
+            // The host renders the inline display, the audio thread leaves the headless mode
+            atomic_add(&nIDisplayDraws, 1);
+
             // Check proportions
             if (height > (M_RGOLD_RATIO * width))
                 height  = M_RGOLD_RATIO * width;
@@ -1325,11 +3255,10 @@ namespace lsp
             b->v[3][0]          = 1.0f;
             b->v[3][width+1]    = 1.0f;
 
-            size_t channels = ((nMode == EQ_MONO) || (nMode == EQ_STEREO)) ? 1 : 2;
             bool aa = cv->set_anti_aliasing(true);
             cv->set_line_width(2);
 
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; i += nLinks)
             {
                 eq_channel_t *c = &vChannels[i];
 
@@ -1346,7 +3275,13 @@ namespace lsp
                 dsp::axis_apply_log1(b->v[2], b->v[3], zy, dy, width+2);
 
                 // Draw mesh
-                uint32_t color = (bypassing || !(active())) ? CV_SILVER : CV_MIDDLE_CHANNEL;
+                uint32_t color = (nMode == EQ_MID_SIDE) ?
+                    ((i & 1) ? CV_SIDE_CHANNEL : CV_MIDDLE_CHANNEL) :
+                    ((i & 1) ? CV_RIGHT_CHANNEL : CV_LEFT_CHANNEL);
+                if (nLinks >= nChannels)
+                    color = CV_MIDDLE_CHANNEL;
+                if (bypassing || !(active()))
+                    color = CV_SILVER;
                 Color stroke(color), fill(color, 0.5f);
                 cv->draw_poly(b->v[1], b->v[2], width+2, stroke, fill);
             }
@@ -1369,41 +3304,126 @@ namespace lsp
             v->end_object();
         }
 
+        void filter::dump_ramp(dspu::IStateDumper *v, const char *id, const filter_ramp_t *r)
+        {
+            v->begin_object(id, r, sizeof(*r));
+            {
+                dump_filter_params(v, "sCurr", &r->sCurr);
+                v->write("fFreqK", r->fFreqK);
+                v->write("fFreq2K", r->fFreq2K);
+                v->write("fGainK", r->fGainK);
+                v->write("fQualityD", r->fQualityD);
+                v->write("nSteps", r->nSteps);
+                v->write("nStepSize", r->nStepSize);
+                v->write("nOffset", r->nOffset);
+            }
+            v->end_object();
+        }
+
+        void filter::dump_filter(dspu::IStateDumper *v, const eq_filter_t *f)
+        {
+            v->begin_object(f, sizeof(eq_filter_t));
+            {
+                dump_filter_params(v, "sOldFP", &f->sOldFP);
+                dump_filter_params(v, "sFP", &f->sFP);
+                dump_filter_params(v, "sDesignFP", &f->sDesignFP);
+                dump_ramp(v, "sRamp", &f->sRamp);
+
+                v->write("pEnable", f->pEnable);
+                v->write("pType", f->pType);
+                v->write("pMode", f->pMode);
+                v->write("pFreq", f->pFreq);
+                v->write("pWidth", f->pWidth);
+                v->write("pSlope", f->pSlope);
+                v->write("pGain", f->pGain);
+                v->write("pQuality", f->pQuality);
+            }
+            v->end_object();
+        }
+
         void filter::dump_channel(dspu::IStateDumper *v, const eq_channel_t *c) const
         {
             v->begin_object(c, sizeof(eq_channel_t));
             {
-                v->write_object("sOversampler", &c->sOversampler);
-                v->write_object("sEqualizer", &c->sEqualizer);
+                v->begin_array("vOversampler", c->vOversampler, 2);
+                {
+                    for (size_t i=0; i<2; ++i)
+                        v->write_object(&c->vOversampler[i]);
+                }
+                v->end_array();
+                v->write("pOversampler", c->pOversampler);
+                v->write("pOvsNext", c->pOvsNext);
+                v->begin_array("vEqualizer", c->vEqualizer, 2);
+                {
+                    for (size_t i=0; i<2; ++i)
+                        v->write_object(&c->vEqualizer[i]);
+                }
+                v->end_array();
+                v->write("pEqualizer", c->pEqualizer);
+                v->write("pDesign", c->pDesign);
+                v->begin_array("vConvolver", c->vConvolver, 2);
+                {
+                    for (size_t i=0; i<2; ++i)
+                        v->write_object(&c->vConvolver[i]);
+                }
+                v->end_array();
+                v->write("pConvolver", c->pConvolver);
+                v->write("pConvNext", c->pConvNext);
+                v->begin_array("vAlign", c->vAlign, 2);
+                {
+                    for (size_t i=0; i<2; ++i)
+                        v->write_object(&c->vAlign[i]);
+                }
+                v->end_array();
+                v->write("pAlign", c->pAlign);
+                v->write("pAlignNext", c->pAlignNext);
                 v->write_object("sBypass", &c->sBypass);
                 v->write_object("sDryDelay", &c->sDryDelay);
 
-                dump_filter_params(v, "sOldFP", &c->sOldFP);
-                dump_filter_params(v, "sFP", &c->sFP);
+                v->begin_array("vFilters", c->vFilters, nFilters);
+                {
+                    for (size_t i=0; i<nFilters; ++i)
+                        dump_filter(v, &c->vFilters[i]);
+                }
+                v->end_array();
 
                 v->write("nLatency", c->nLatency);
-                v->write("fInGain", c->fInGain);
+                v->write("nPad", c->nPad);
+                v->write("nDesignPad", c->nDesignPad);
+                v->write("nDesignLatency", c->nDesignLatency);
                 v->write("fOutGain", c->fOutGain);
                 v->write("vDryBuf", c->vDryBuf);
                 v->write("vInBuffer", c->vInBuffer);
                 v->write("vOutBuffer", c->vOutBuffer);
+                v->write("vOvsBuffer", c->vOvsBuffer);
+                v->write("vXfBuffer", c->vXfBuffer);
+                v->write("vPreroll", c->vPreroll);
                 v->write("vIn", c->vIn);
                 v->write("vOut", c->vOut);
                 v->write("vInPtr", c->vInPtr);
                 v->write("vTr", c->vTr);
                 v->write("vTrMem", c->vTrMem);
                 v->write("nSync", c->nSync);
-
-                v->write("pType", c->pType);
-                v->write("pMode", c->pMode);
-                v->write("pFreq", c->pFreq);
-                v->write("pSlope", c->pSlope);
-                v->write("pGain", c->pGain);
-                v->write("pQuality", c->pQuality);
+                v->write("nDesign", c->nDesign);
+                v->write("nXfOffset", c->nXfOffset);
+                v->write("nXfLength", c->nXfLength);
+                v->write("bDesign", c->bDesign);
+                v->write("nRank", c->nRank);
+                v->write("nDesignRank", c->nDesignRank);
+                v->write("nDecramp", c->nDecramp);
+                v->write("nDesignDecramp", c->nDesignDecramp);
+                v->write("nKernel", c->nKernel);
+                v->write("nDesignKernel", c->nDesignKernel);
+                v->write("bRedesign", c->bRedesign);
+                v->write("bOvsNext", c->bOvsNext);
+                v->write("bAlign", c->bAlign);
+                v->write("nIdentity", c->nIdentity);
+                v->write("nIdOffset", c->nIdOffset);
+                v->write("nIdLength", c->nIdLength);
+                v->write("bIdentity", c->bIdentity);
 
                 v->write("pIn", c->pIn);
                 v->write("pOut", c->pOut);
-                v->write("pInGain", c->pInGain);
                 v->write("pTrAmp", c->pTrAmp);
                 v->write("pFftInSwitch", c->pFftInSwitch);
                 v->write("pFftOutSwitch", c->pFftOutSwitch);
@@ -1419,32 +3439,138 @@ namespace lsp
         {
             plug::Module::dump(v);
 
-            size_t channels     = (nMode == EQ_MONO) ? 1 : 2;
 
             v->write_object("sAnalyzer", &sAnalyzer);
+            v->begin_object("sAnalysis", &sAnalysis, sizeof(sAnalysis));
+            {
+                v->begin_array("vRing", sAnalysis.vRing, 4);
+                {
+                    for (size_t i=0; i<4; ++i)
+                        v->write(sAnalysis.vRing[i]);
+                }
+                v->end_array();
+                v->begin_array("vSpectrum", sAnalysis.vSpectrum, 4);
+                {
+                    for (size_t i=0; i<4; ++i)
+                        v->write(sAnalysis.vSpectrum[i]);
+                }
+                v->end_array();
+                v->write("nHead", sAnalysis.nHead);
+                v->write("nTail", sAnalysis.nTail);
+                v->write("nCount", sAnalysis.nCount);
+                v->write("nDelay", sAnalysis.nDelay);
+                v->write("nRank", sAnalysis.nRank);
+                v->write("nMaxRank", sAnalysis.nMaxRank);
+                v->write("nChannels", sAnalysis.nChannels);
+                v->write("nSource", sAnalysis.nSource);
+                v->write("fReactivity", sAnalysis.fReactivity);
+                v->write("fShift", sAnalysis.fShift);
+                v->writev("vEnable", sAnalysis.vEnable, 4);
+                v->write("bActive", sAnalysis.bActive);
+                v->write("bSync", sAnalysis.bSync);
+                v->write("bRealloc", sAnalysis.bRealloc);
+            }
+            v->end_object();
             v->write("nMode", nMode);
+            v->write("nChannels", nChannels);
+            v->write("nLinks", nLinks);
+            v->write("nFilters", nFilters);
             v->write("nDecramp", nDecramp);
-            v->begin_array("vChannels", vChannels, channels);
+            v->write("nKernel", nKernel);
+            v->write("nResampler", nResampler);
+            v->write("nTailLength", nTailLength);
+            v->write("nIdle", nIdle);
+            v->write("nIDisplay", nIDisplay);
+            v->write("nIDisplayQuery", nIDisplayQuery);
+            v->write("nIDisplayDraws", nIDisplayDraws);
+            v->write("nIDisplaySeen", nIDisplaySeen);
+            v->write("nPrerollHead", nPrerollHead);
+            v->write("nKernelRank", nKernelRank);
+            v->begin_object("sDesign", &sDesign, sizeof(sDesign));
             {
-                for (size_t i=0; i<channels; ++i)
+                v->write("nRank", sDesign.nRank);
+                v->write("nMode", sDesign.nMode);
+                v->write("nKernel", sDesign.nKernel);
+                v->write("nDecramp", sDesign.nDecramp);
+                v->write("nQuality", sDesign.nQuality);
+                v->write("fSampleRate", sDesign.fSampleRate);
+                v->write("fEqRate", sDesign.fEqRate);
+            }
+            v->end_object();
+            v->write("nLatency", nLatency);
+            v->write("nMaxLatency", nMaxLatency);
+            v->writev("vResampleLatency", vResampleLatency, meta::filter_metadata::RESAMPLER_QUALITIES);
+            v->begin_object("sLatency", vStageLatency, sizeof(vStageLatency));
+            {
+                v->write("nOversampler", vStageLatency[LS_OVERSAMPLER]);
+                v->write("nEqualizer", vStageLatency[LS_EQUALIZER]);
+            }
+            v->end_object();
+            v->begin_array("vChannels", vChannels, nChannels);
+            {
+                for (size_t i=0; i<nChannels; ++i)
                     dump_channel(v, &vChannels[i]);
             }
             v->end_array();
             v->write("vFreqs", vFreqs);
+            v->begin_object("sKernel", &sKernel, sizeof(kernel_buf_t));
+            {
+                v->write("vKernel", sKernel.vKernel);
+                v->write("vRe", sKernel.vRe);
+                v->write("vIm", sKernel.vIm);
+                v->write("vFreq", sKernel.vFreq);
+                v->write("vTr", sKernel.vTr);
+                v->write("nRank", sKernel.nRank);
+                v->write("pData", sKernel.pData);
+            }
+            v->end_object();
             v->write("vIndexes", vIndexes);
             v->write("fGainIn", fGainIn);
             v->write("fZoom", fZoom);
-            v->write("bSmoothMode", bSmoothMode);
+            v->write("fSmoothTime", fSmoothTime);
             v->write_object("pIDisplay", pIDisplay);
             v->write("pBypass", pBypass);
             v->write("pGainIn", pGainIn);
             v->write("pGainOut", pGainOut);
             v->write("pReactivity", pReactivity);
+            v->write("pFftRes", pFftRes);
+            v->write("pFftChannel", pFftChannel);
             v->write("pShiftGain", pShiftGain);
             v->write("pZoom", pZoom);
             v->write("pEqMode", pEqMode);
             v->write("pEqDecramp", pEqDecramp);
+            v->write("pResampler", pResampler);
+            v->write("pSmooth", pSmooth);
             v->write("pBalance", pBalance);
+            v->write("pMeters", pMeters);
+            v->write("pLatency", pLatency);
+            v->write("bUIActive", bUIActive);
+            v->write("bIDisplayQuery", bIDisplayQuery);
+            v->write("bIDisplayDirty", bIDisplayDirty);
+            v->write("bVisual", bVisual);
+            v->write("bBypassed", bBypassed);
+            v->write("bAutoDecramp", bAutoDecramp);
+            v->write("bIdle", bIdle);
+            v->write("bProfile", bProfile);
+            v->write("bMeters", bMeters);
+            v->begin_object("sProfile", vStageTime, sizeof(vStageTime));
+            {
+                v->write("nDryDelay", size_t(vStageTime[PS_DRY_DELAY]));
+                v->write("nInput", size_t(vStageTime[PS_INPUT]));
+                v->write("nOversampler", size_t(vStageTime[PS_OVERSAMPLER]));
+                v->write("nEqualizer", size_t(vStageTime[PS_EQUALIZER]));
+                v->write("nAnalyzer", size_t(vStageTime[PS_ANALYZER]));
+                v->write("nOutput", size_t(vStageTime[PS_OUTPUT]));
+
+                v->write("fDryDelayLoad", vStageLoad[PS_DRY_DELAY]);
+                v->write("fInputLoad", vStageLoad[PS_INPUT]);
+                v->write("fOversamplerLoad", vStageLoad[PS_OVERSAMPLER]);
+                v->write("fEqualizerLoad", vStageLoad[PS_EQUALIZER]);
+                v->write("fAnalyzerLoad", vStageLoad[PS_ANALYZER]);
+                v->write("fOutputLoad", vStageLoad[PS_OUTPUT]);
+            }
+            v->end_object();
+            v->write("pProfile", pProfile);
         }
 
     } /* namespace plugins */
@@ -39,7 +39,13 @@ namespace lsp
         static const meta::plugin_t *plugin_uis[] =
         {
             &meta::filter_mono,
-            &meta::filter_stereo
+            &meta::filter_stereo,
+            &meta::filter_x4_mono,
+            &meta::filter_x4_stereo,
+            &meta::filter_lr,
+            &meta::filter_ms,
+            &meta::filter_x8_multi,
+            &meta::filter_x16_multi
         };
 
         static ui::Module *ui_factory(const meta::plugin_t *meta)
@@ -47,7 +53,7 @@ namespace lsp
             return new filter_ui(meta);
         }
 
-        static ui::Factory factory(ui_factory, plugin_uis, 2);
+        static ui::Factory factory(ui_factory, plugin_uis, 8);
 
 
         //---------------------------------------------------------------------
@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-filter
+ * Created on: 16 окт. 2026 г.
+ *
+ * lsp-plugins-filter is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-filter is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-filter. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/plug-fw/meta/func.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include "plugin_host.h"
+
+namespace lsp
+{
+    namespace test
+    {
+        //---------------------------------------------------------------------
+        HostPort::HostPort(const meta::port_t *meta): plug::IPort(meta)
+        {
+            fValue      = meta->start;
+            pBuffer     = NULL;
+        }
+
+        HostPort::~HostPort()
+        {
+            pBuffer     = NULL;
+        }
+
+        float HostPort::value()
+        {
+            return fValue;
+        }
+
+        void HostPort::set_value(float value)
+        {
+            fValue      = value;
+        }
+
+        void *HostPort::buffer()
+        {
+            return pBuffer;
+        }
+
+        //---------------------------------------------------------------------
+        InlineExecutor::InlineExecutor()
+        {
+        }
+
+        InlineExecutor::~InlineExecutor()
+        {
+        }
+
+        bool InlineExecutor::submit(ipc::ITask *task)
+        {
+            if (!task->idle())
+                return false;
+
+            change_task_state(task, ipc::ITask::TS_SUBMITTED);
+            run_task(task);
+            return true;
+        }
+
+        void InlineExecutor::shutdown()
+        {
+        }
+
+        //---------------------------------------------------------------------
+        HostWrapper::HostWrapper(plug::Module *module, ipc::IExecutor *executor): plug::IWrapper(module, NULL)
+        {
+            pExecutor   = executor;
+        }
+
+        HostWrapper::~HostWrapper()
+        {
+            pExecutor   = NULL;
+        }
+
+        ipc::IExecutor *HostWrapper::executor()
+        {
+            return pExecutor;
+        }
+
+        //---------------------------------------------------------------------
+        PluginHost::PluginHost()
+        {
+            pModule     = NULL;
+            pWrapper    = NULL;
+            pExecutor   = NULL;
+            vData       = NULL;
+            nBlockSize  = 0;
+            bUpdate     = false;
+        }
+
+        PluginHost::~PluginHost()
+        {
+            destroy();
+        }
+
+        status_t PluginHost::init(plug::Module *module, long sample_rate, size_t block_size, bool executor)
+        {
+            if (module == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            pModule     = module;
+            nBlockSize  = block_size;
+
+            // Create ports
+            const meta::plugin_t *meta = module->metadata();
+            for (const meta::port_t *p = meta->ports; p->id != NULL; ++p)
+            {
+                HostPort *port  = new HostPort(p);
+                if (port == NULL)
+                    return STATUS_NO_MEM;
+                if (!vPorts.add(port))
+                {
+                    delete port;
+                    return STATUS_NO_MEM;
+                }
+
+                if (meta::is_audio_in_port(p))
+                {
+                    if (!vInputs.add(port))
+                        return STATUS_NO_MEM;
+                }
+                else if (meta::is_audio_out_port(p))
+                {
+                    if (!vOutputs.add(port))
+                        return STATUS_NO_MEM;
+                }
+            }
+
+            // Allocate audio buffers
+            const size_t buffers    = vInputs.size() + vOutputs.size();
+            vData                   = new float[buffers * block_size];
+            if (vData == NULL)
+                return STATUS_NO_MEM;
+            dsp::fill_zero(vData, buffers * block_size);
+
+            float *ptr              = vData;
+            for (size_t i=0, n=vInputs.size(); i<n; ++i)
+                vInputs.uget(i)->bind(advance_ptr<float>(ptr, block_size));
+            for (size_t i=0, n=vOutputs.size(); i<n; ++i)
+                vOutputs.uget(i)->bind(advance_ptr<float>(ptr, block_size));
+
+            // Create wrapper and initialize the module
+            if (executor)
+            {
+                pExecutor               = new InlineExecutor();
+                if (pExecutor == NULL)
+                    return STATUS_NO_MEM;
+            }
+            pWrapper                = new HostWrapper(module, pExecutor);
+            if (pWrapper == NULL)
+                return STATUS_NO_MEM;
+
+            module->init(pWrapper, reinterpret_cast<plug::IPort **>(vPorts.array()));
+            module->set_sample_rate(sample_rate);
+            module->activate();
+            bUpdate                 = true;
+
+            return STATUS_OK;
+        }
+
+        void PluginHost::destroy()
+        {
+            if (pModule != NULL)
+            {
+                pModule->deactivate();
+                pModule->destroy();
+                delete pModule;
+                pModule     = NULL;
+            }
+
+            if (pWrapper != NULL)
+            {
+                delete pWrapper;
+                pWrapper    = NULL;
+            }
+
+            if (pExecutor != NULL)
+            {
+                pExecutor->shutdown();
+                delete pExecutor;
+                pExecutor   = NULL;
+            }
+
+            for (size_t i=0, n=vPorts.size(); i<n; ++i)
+            {
+                HostPort *p = vPorts.uget(i);
+                if (p != NULL)
+                    delete p;
+            }
+            vPorts.flush();
+            vInputs.flush();
+            vOutputs.flush();
+
+            if (vData != NULL)
+            {
+                delete [] vData;
+                vData       = NULL;
+            }
+        }
+
+        HostPort *PluginHost::port(const char *id)
+        {
+            for (size_t i=0, n=vPorts.size(); i<n; ++i)
+            {
+                HostPort *p = vPorts.uget(i);
+                if (!strcmp(p->metadata()->id, id))
+                    return p;
+            }
+            return NULL;
+        }
+
+        bool PluginHost::set(const char *id, float value)
+        {
+            HostPort *p = port(id);
+            if (p == NULL)
+                return false;
+
+            if (p->value() != value)
+            {
+                p->set_value(value);
+                bUpdate     = true;
+            }
+            return true;
+        }
+
+        float PluginHost::get(const char *id)
+        {
+            HostPort *p = port(id);
+            return (p != NULL) ? p->value() : 0.0f;
+        }
+
+        float *PluginHost::input(size_t index)
+        {
+            HostPort *p = vInputs.get(index);
+            return (p != NULL) ? p->buffer<float>() : NULL;
+        }
+
+        float *PluginHost::output(size_t index)
+        {
+            HostPort *p = vOutputs.get(index);
+            return (p != NULL) ? p->buffer<float>() : NULL;
+        }
+
+        void PluginHost::process(size_t samples)
+        {
+            if (bUpdate)
+            {
+                pModule->update_settings();
+                bUpdate     = false;
+            }
+
+            pModule->process(lsp_min(samples, nBlockSize));
+        }
+
+    } /* namespace test */
+} /* namespace lsp */
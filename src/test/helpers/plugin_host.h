@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-filter
+ * Created on: 16 окт. 2026 г.
+ *
+ * lsp-plugins-filter is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-filter is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-filter. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_HELPERS_PLUGIN_HOST_H_
+#define TEST_HELPERS_PLUGIN_HOST_H_
+
+#include <lsp-plug.in/plug-fw/plug.h>
+#include <lsp-plug.in/ipc/IExecutor.h>
+#include <lsp-plug.in/lltl/parray.h>
+
+namespace lsp
+{
+    namespace test
+    {
+        /**
+         * Simple port that stores the value or points to the data buffer
+         */
+        class HostPort: public plug::IPort
+        {
+            protected:
+                float               fValue;
+                void               *pBuffer;
+
+            public:
+                explicit HostPort(const meta::port_t *meta);
+                HostPort(const HostPort &) = delete;
+                HostPort(HostPort &&) = delete;
+                virtual ~HostPort() override;
+
+                HostPort & operator = (const HostPort &) = delete;
+                HostPort & operator = (HostPort &&) = delete;
+
+            public:
+                virtual float       value() override;
+                virtual void        set_value(float value) override;
+                virtual void       *buffer() override;
+
+            public:
+                inline void         bind(void *buffer)  { pBuffer = buffer; }
+        };
+
+        /**
+         * Executor which runs the submitted task in place, so the background
+         * tasks of the module complete before the next process() call
+         */
+        class InlineExecutor: public ipc::IExecutor
+        {
+            public:
+                explicit InlineExecutor();
+                InlineExecutor(const InlineExecutor &) = delete;
+                InlineExecutor(InlineExecutor &&) = delete;
+                virtual ~InlineExecutor() override;
+
+                InlineExecutor & operator = (const InlineExecutor &) = delete;
+                InlineExecutor & operator = (InlineExecutor &&) = delete;
+
+            public:
+                virtual bool        submit(ipc::ITask *task) override;
+                virtual void        shutdown() override;
+        };
+
+        /**
+         * Minimal wrapper which allows to run the plugin module without any real host
+         */
+        class HostWrapper: public plug::IWrapper
+        {
+            protected:
+                ipc::IExecutor     *pExecutor;
+
+            public:
+                explicit HostWrapper(plug::Module *module, ipc::IExecutor *executor);
+                HostWrapper(const HostWrapper &) = delete;
+                HostWrapper(HostWrapper &&) = delete;
+                virtual ~HostWrapper() override;
+
+                HostWrapper & operator = (const HostWrapper &) = delete;
+                HostWrapper & operator = (HostWrapper &&) = delete;
+
+            public:
+                virtual ipc::IExecutor *executor() override;
+        };
+
+        /**
+         * Headless host for the plugin module: creates ports from the plugin metadata,
+         * allocates audio buffers and drives the processing
+         */
+        class PluginHost
+        {
+            protected:
+                plug::Module               *pModule;
+                HostWrapper                *pWrapper;
+                InlineExecutor             *pExecutor;
+                lltl::parray<HostPort>      vPorts;
+                lltl::parray<HostPort>      vInputs;
+                lltl::parray<HostPort>      vOutputs;
+                float                      *vData;
+                size_t                      nBlockSize;
+                bool                        bUpdate;
+
+            public:
+                explicit PluginHost();
+                PluginHost(const PluginHost &) = delete;
+                PluginHost(PluginHost &&) = delete;
+                ~PluginHost();
+
+                PluginHost & operator = (const PluginHost &) = delete;
+                PluginHost & operator = (PluginHost &&) = delete;
+
+            public:
+                /**
+                 * Initialize host, the host takes ownership of the module
+                 * @param module module to host
+                 * @param sample_rate sample rate
+                 * @param block_size maximum size of the block passed to the process() call
+                 * @param executor provide the executor which runs background tasks in place,
+                 *   otherwise the module does not get any executor
+                 * @return status of operation
+                 */
+                status_t            init(plug::Module *module, long sample_rate, size_t block_size, bool executor = false);
+
+                /**
+                 * Destroy the hosted module and release all resources
+                 */
+                void                destroy();
+
+            public:
+                HostPort           *port(const char *id);
+                bool                set(const char *id, float value);
+                float               get(const char *id);
+
+                inline plug::Module    *module()                { return pModule;               }
+                inline size_t           block_size() const      { return nBlockSize;            }
+                inline size_t           inputs() const          { return vInputs.size();        }
+                inline size_t           outputs() const         { return vOutputs.size();       }
+
+                float              *input(size_t index);
+                float              *output(size_t index);
+
+                /**
+                 * Apply pending settings and process the data stored in the input buffers
+                 * @param samples number of samples to process, should not exceed block size
+                 */
+                void                process(size_t samples);
+        };
+
+    } /* namespace test */
+} /* namespace lsp */
+
+#endif /* TEST_HELPERS_PLUGIN_HOST_H_ */
@@ -0,0 +1,421 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-filter
+ * Created on: 16 окт. 2026 г.
+ *
+ * lsp-plugins-filter is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-filter is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-filter. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/mtest.h>
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/fmt/config/PullParser.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/lltl/darray.h>
+#include <lsp-plug.in/mm/InAudioFileStream.h>
+#include <lsp-plug.in/mm/OutAudioFileStream.h>
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <private/plugins/filter.h>
+
+#include "../helpers/plugin_host.h"
+
+namespace
+{
+    using namespace lsp;
+
+    static constexpr size_t RENDER_BLOCK_SIZE   = 0x4000;
+
+    static const char *single_ids[]         = { "", NULL };
+    static const char *stereo_ids[]         = { "_l", "_r", NULL };
+    static const char *ms_ids[]             = { "_m", "_s", NULL };
+
+    typedef struct plugin_layout_t
+    {
+        const meta::plugin_t   *metadata;
+        size_t                  channels;
+        size_t                  filters;
+        size_t                  mode;
+        const char * const     *an_ids;     // Suffixes of the analysis ports
+    } plugin_layout_t;
+
+    // The first layout with the matching number of channels is selected by default
+    static const plugin_layout_t layouts[] =
+    {
+        { &meta::filter_mono,       1,  1,                                  plugins::filter::EQ_MONO,       single_ids  },
+        { &meta::filter_stereo,     2,  1,                                  plugins::filter::EQ_STEREO,     stereo_ids  },
+        { &meta::filter_x4_mono,    1,  meta::filter_metadata::FILTERS_X4,  plugins::filter::EQ_MONO,       single_ids  },
+        { &meta::filter_x4_stereo,  2,  meta::filter_metadata::FILTERS_X4,  plugins::filter::EQ_STEREO,     stereo_ids  },
+        { &meta::filter_lr,         2,  1,                                  plugins::filter::EQ_LEFT_RIGHT, stereo_ids  },
+        { &meta::filter_ms,         2,  1,                                  plugins::filter::EQ_MID_SIDE,   ms_ids      },
+        { &meta::filter_x8_multi,   8,  1,                                  plugins::filter::EQ_MULTI,      single_ids  },
+        { &meta::filter_x16_multi,  16, 1,                                  plugins::filter::EQ_MULTI,      single_ids  },
+        { NULL, 0, 0, 0, NULL }
+    };
+
+    typedef struct preset_value_t
+    {
+        char       *id;
+        float       value;
+    } preset_value_t;
+
+    typedef struct render_job_t
+    {
+        const char                     *out_dir;
+        const char                     *plugin;
+        lltl::darray<preset_value_t>   *preset;
+        lltl::parray<char>             *files;
+        uatomic_t                       next;
+        uatomic_t                       errors;
+    } render_job_t;
+
+    static status_t load_preset(lltl::darray<preset_value_t> *list, const char *path)
+    {
+        config::PullParser parser;
+        config::param_t param;
+
+        status_t res = parser.open(path);
+        if (res != STATUS_OK)
+            return res;
+
+        while ((res = parser.next(&param)) == STATUS_OK)
+        {
+            float value;
+            if (param.is_bool())
+                value       = (param.v.bval) ? 1.0f : 0.0f;
+            else if (param.is_numeric())
+            {
+                value       = param.to_f32();
+                if (param.flags & config::SF_DECIBELS)
+                    value       = dspu::db_to_gain(value);
+            }
+            else
+                continue;
+
+            preset_value_t *v   = list->add();
+            if (v == NULL)
+                return STATUS_NO_MEM;
+            v->id       = param.name.clone_utf8();
+            v->value    = value;
+            if (v->id == NULL)
+                return STATUS_NO_MEM;
+        }
+
+        parser.close();
+        return (res == STATUS_EOF) ? STATUS_OK : res;
+    }
+
+    static void destroy_preset(lltl::darray<preset_value_t> *list)
+    {
+        for (size_t i=0, n=list->size(); i<n; ++i)
+        {
+            preset_value_t *v   = list->uget(i);
+            if (v->id != NULL)
+                free(v->id);
+        }
+        list->flush();
+    }
+
+    static const plugin_layout_t *find_layout(const char *uid, size_t channels)
+    {
+        for (const plugin_layout_t *l = layouts; l->metadata != NULL; ++l)
+        {
+            if (l->channels != channels)
+                continue;
+            if ((uid == NULL) || (!strcmp(l->metadata->uid, uid)))
+                return l;
+        }
+        return NULL;
+    }
+
+    static status_t make_output_path(io::Path *path, const char *out_dir, const char *src)
+    {
+        io::Path name;
+        status_t res;
+
+        if ((res = path->set(out_dir)) != STATUS_OK)
+            return res;
+        if ((res = name.set(src)) != STATUS_OK)
+            return res;
+        if ((res = name.get_last(&name)) != STATUS_OK)
+            return res;
+        return path->append_child(&name);
+    }
+
+    static status_t render_stream(test::PluginHost *host, mm::IInAudioStream *is, mm::IOutAudioStream *os,
+        float *buf, size_t channels, size_t latency)
+    {
+        wssize_t read           = 0;    // Number of frames read from the source file
+        wssize_t written        = 0;    // Number of frames written to the destination file
+        wssize_t processed      = 0;    // Number of frames processed by the plugin
+        bool eof                = false;
+
+        // Render the data with latency compensation, the tail of the latency is rendered after the end of file
+        while ((!eof) || (written < read))
+        {
+            size_t avail            = 0;
+            if (!eof)
+            {
+                const ssize_t count     = is->read(buf, RENDER_BLOCK_SIZE);
+                if (count > 0)
+                    avail                   = count;
+                else if ((count == 0) || (count == -STATUS_EOF))
+                    eof                     = true;
+                else
+                    return status_t(-count);
+            }
+            read                   += avail;
+
+            // Deinterleave the input data
+            const size_t to_do      = (avail > 0) ? avail : RENDER_BLOCK_SIZE;
+            for (size_t i=0; i<channels; ++i)
+            {
+                float *dst              = host->input(i);
+                for (size_t j=0; j<avail; ++j)
+                    dst[j]                  = buf[j*channels + i];
+                dsp::fill_zero(&dst[avail], to_do - avail);
+            }
+
+            host->process(to_do);
+
+            // Skip the latency at the beginning of the stream and interleave the output data
+            const size_t skip       = (processed < wssize_t(latency)) ? lsp_min(size_t(wssize_t(latency) - processed), to_do) : 0;
+            const size_t count      = lsp_min(wssize_t(to_do - skip), read - written);
+            for (size_t i=0; i<channels; ++i)
+            {
+                const float *src        = &host->output(i)[skip];
+                for (size_t j=0; j<count; ++j)
+                    buf[j*channels + i]     = src[j];
+            }
+            processed              += to_do;
+
+            for (size_t done=0; done < count; )
+            {
+                const ssize_t n         = os->write(&buf[done * channels], count - done);
+                if (n < 0)
+                    return status_t(-n);
+                done                   += n;
+            }
+            written                += count;
+        }
+
+        return STATUS_OK;
+    }
+
+    static status_t render_file(const render_job_t *job, const char *src)
+    {
+        mm::InAudioFileStream is;
+        mm::OutAudioFileStream os;
+        mm::audio_stream_t fmt;
+        status_t res;
+
+        // Open the source file
+        if ((res = is.open(src)) != STATUS_OK)
+        {
+            fprintf(stderr, "Could not open file '%s', error code=%d\n", src, int(res));
+            return res;
+        }
+        if ((res = is.info(&fmt)) != STATUS_OK)
+        {
+            fprintf(stderr, "Could not read format of file '%s', error code=%d\n", src, int(res));
+            is.close();
+            return res;
+        }
+
+        // Instantiate the plugin
+        const size_t channels           = fmt.channels;
+        const plugin_layout_t *layout   = find_layout(job->plugin, channels);
+        if (layout == NULL)
+        {
+            fprintf(stderr, "No plugin %s matches %d channels of file '%s'\n",
+                (job->plugin != NULL) ? job->plugin : "", int(channels), src);
+            is.close();
+            return STATUS_UNSUPPORTED_FORMAT;
+        }
+        const meta::plugin_t *meta      = layout->metadata;
+
+        test::PluginHost host;
+        if ((res = host.init(new plugins::filter(meta, channels, layout->filters, layout->mode), fmt.srate, RENDER_BLOCK_SIZE)) != STATUS_OK)
+        {
+            fprintf(stderr, "Could not instantiate plugin %s, error code=%d\n", meta->uid, int(res));
+            is.close();
+            return res;
+        }
+
+        // Apply the preset and disable all analysis
+        for (size_t i=0, n=job->preset->size(); i<n; ++i)
+        {
+            const preset_value_t *v = job->preset->uget(i);
+            host.set(v->id, v->value);
+        }
+        for (const char * const *sfx = layout->an_ids; *sfx != NULL; ++sfx)
+        {
+            char id[32];
+            snprintf(id, sizeof(id), "ife%s", *sfx);
+            host.set(id, 0.0f);
+            snprintf(id, sizeof(id), "ofe%s", *sfx);
+            host.set(id, 0.0f);
+        }
+
+        // Apply the settings to obtain the actual latency
+        host.process(0);
+        const size_t latency    = host.module()->latency();
+
+        // Create the destination file
+        io::Path path;
+        if ((res = make_output_path(&path, job->out_dir, src)) != STATUS_OK)
+        {
+            is.close();
+            return res;
+        }
+
+        fmt.format              = mm::SFMT_F32_CPU;
+        if ((res = os.open(&path, &fmt, mm::AFMT_WAV | mm::CFMT_PCM)) != STATUS_OK)
+        {
+            fprintf(stderr, "Could not create file '%s', error code=%d\n", path.as_native(), int(res));
+            is.close();
+            return res;
+        }
+
+        // Stream the data through the plugin block by block
+        uint8_t *data           = NULL;
+        float *buf              = alloc_aligned<float>(data, RENDER_BLOCK_SIZE * channels);
+        res                     = (buf != NULL) ?
+            render_stream(&host, &is, &os, buf, channels, latency) : STATUS_NO_MEM;
+        free_aligned(data);
+        host.destroy();
+
+        const status_t res_out  = os.close();
+        is.close();
+        if (res == STATUS_OK)
+            res                     = res_out;
+        if (res != STATUS_OK)
+        {
+            fprintf(stderr, "Could not render file '%s', error code=%d\n", src, int(res));
+            return res;
+        }
+
+        printf("Rendered '%s' -> '%s' by %s, latency compensated: %d samples\n", src, path.as_native(), meta->uid, int(latency));
+        return STATUS_OK;
+    }
+
+    static status_t render_worker(void *arg)
+    {
+        render_job_t *job   = static_cast<render_job_t *>(arg);
+
+        while (true)
+        {
+            const size_t index  = atomic_add(&job->next, 1);
+            const char *file    = job->files->get(index);
+            if (file == NULL)
+                break;
+
+            if (render_file(job, file) != STATUS_OK)
+                atomic_add(&job->errors, 1);
+        }
+
+        return STATUS_OK;
+    }
+}
+
+MTEST_BEGIN("filter", render)
+
+    void usage()
+    {
+        printf("Renders audio files through the filter plugin using the preset file.\n");
+        printf("Arguments: -p <preset.cfg> -o <output directory> [-m <plugin>] [-j <number of jobs>] <file> [<file> ...]\n");
+        printf("Files are streamed through the plugin block by block and saved as 32-bit float WAV files.\n");
+        printf("By default mono files are processed by filter_mono, stereo files by filter_stereo,\n");
+        printf("8-channel files by filter_x8_multi and 16-channel files by filter_x16_multi.\n");
+        printf("The -m option selects other plugin for the matching files, for example filter_ms.\n");
+    }
+
+    MTEST_MAIN
+    {
+        const char *preset_file = NULL;
+        render_job_t job;
+        lltl::darray<preset_value_t> preset;
+        lltl::parray<char> files;
+        size_t jobs             = ipc::Thread::system_cpus();
+
+        job.out_dir             = NULL;
+        job.plugin              = NULL;
+        job.preset              = &preset;
+        job.files               = &files;
+        job.next                = 0;
+        job.errors              = 0;
+
+        // Parse arguments
+        for (int i=0; i<argc; ++i)
+        {
+            if ((!strcmp(argv[i], "-p")) && (i+1 < argc))
+                preset_file         = argv[++i];
+            else if ((!strcmp(argv[i], "-o")) && (i+1 < argc))
+                job.out_dir         = argv[++i];
+            else if ((!strcmp(argv[i], "-m")) && (i+1 < argc))
+                job.plugin          = argv[++i];
+            else if ((!strcmp(argv[i], "-j")) && (i+1 < argc))
+                jobs                = atoi(argv[++i]);
+            else
+                MTEST_ASSERT(files.add(const_cast<char *>(argv[i])));
+        }
+
+        if ((preset_file == NULL) || (job.out_dir == NULL) || (files.is_empty()))
+        {
+            usage();
+            return;
+        }
+        jobs                    = lsp_limit(jobs, size_t(1), files.size());
+
+        // Load the preset
+        status_t res            = load_preset(&preset, preset_file);
+        if (res != STATUS_OK)
+        {
+            fprintf(stderr, "Could not load preset file '%s', error code=%d\n", preset_file, int(res));
+            destroy_preset(&preset);
+            MTEST_FAIL_MSG("Could not load preset");
+        }
+
+        // Launch workers, each worker processes files one by one
+        lltl::parray<ipc::Thread> workers;
+        for (size_t i=0; i<jobs; ++i)
+        {
+            ipc::Thread *t          = new ipc::Thread(render_worker, &job);
+            MTEST_ASSERT(t != NULL);
+            MTEST_ASSERT(workers.add(t));
+            MTEST_ASSERT(t->start() == STATUS_OK);
+        }
+
+        for (size_t i=0, n=workers.size(); i<n; ++i)
+        {
+            ipc::Thread *t          = workers.uget(i);
+            t->join();
+            delete t;
+        }
+        workers.flush();
+        destroy_preset(&preset);
+
+        printf("Processed %d files using %d jobs, %d errors\n", int(files.size()), int(jobs), int(job.errors));
+        MTEST_ASSERT(job.errors == 0);
+    }
+
+MTEST_END
@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-filter
+ * Created on: 16 окт. 2026 г.
+ *
+ * lsp-plugins-filter is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-filter is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-filter. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+
+#include <private/plugins/filter.h>
+
+#include <chrono>
+
+#include "../helpers/plugin_host.h"
+
+namespace
+{
+    using namespace lsp;
+
+    // The kernel transitions should be over before the measurement starts: the warm-up
+    // of the longest kernel and of the decramping resampler, and the crossfade
+    static constexpr size_t KERNEL_SIZE_MAX = 0x8000;
+    static constexpr size_t TRANSITIONS     = 2;
+
+    static const char *eq_modes[]           = { "IIR", "FIR", "FFT", "SPM", "HLP", "HMP" };
+    static const char *decramp_modes[]      = { "x1", "x2", "x3", "x4", "x6", "x8" };
+    static const char *slopes[]             = { "x1", "x2", "x3", "x4", "x6", "x8", "x12", "x16" };
+
+    static constexpr size_t NUM_FILTER_TYPES    = meta::filter_metadata::EQF_ALLPASS + 1;
+    static constexpr size_t NUM_FILTER_MODES    = meta::filter_metadata::EFM_APO_DR + 1;
+    static constexpr size_t NUM_SLOPES          = sizeof(slopes) / sizeof(slopes[0]);
+
+    static const char *single_ids[]         = { "", NULL };
+    static const char *stereo_ids[]         = { "_l", "_r", NULL };
+    static const char *x4_ids[]             = { "_0", "_1", "_2", "_3", NULL };
+    static const char *lr_ids[]             = { "_l", "_r", NULL };
+    static const char *ms_ids[]             = { "_m", "_s", NULL };
+
+    typedef struct layout_t
+    {
+        const meta::plugin_t   *metadata;
+        size_t                  channels;
+        size_t                  filters;
+        size_t                  mode;
+        const char * const     *ids;        // Suffixes of the filter ports
+        const char * const     *an_ids;     // Suffixes of the analysis ports
+    } layout_t;
+
+    static const layout_t layouts[] =
+    {
+        { &meta::filter_mono,       1,  1,                                  plugins::filter::EQ_MONO,       single_ids, single_ids  },
+        { &meta::filter_stereo,     2,  1,                                  plugins::filter::EQ_STEREO,     single_ids, stereo_ids  },
+        { &meta::filter_x4_mono,    1,  meta::filter_metadata::FILTERS_X4,  plugins::filter::EQ_MONO,       x4_ids,     single_ids  },
+        { &meta::filter_x4_stereo,  2,  meta::filter_metadata::FILTERS_X4,  plugins::filter::EQ_STEREO,     x4_ids,     stereo_ids  },
+        { &meta::filter_lr,         2,  1,                                  plugins::filter::EQ_LEFT_RIGHT, lr_ids,     lr_ids      },
+        { &meta::filter_ms,         2,  1,                                  plugins::filter::EQ_MID_SIDE,   ms_ids,     ms_ids      },
+        { &meta::filter_x8_multi,   8,  1,                                  plugins::filter::EQ_MULTI,      single_ids, single_ids  },
+        { &meta::filter_x16_multi,  16, 1,                                  plugins::filter::EQ_MULTI,      single_ids, single_ids  },
+    };
+
+    typedef struct bench_config_t
+    {
+        const layout_t *layout;
+        size_t      eq_mode;
+        size_t      type;
+        size_t      mode;
+        size_t      slope;
+        size_t      decramp;
+        long        sample_rate;
+        size_t      block_size;
+    } bench_config_t;
+
+    // Engine settings measured for the typical filter of the mono plugin
+    typedef struct engine_point_t
+    {
+        size_t      eq_mode;
+        size_t      decramp;
+        long        sample_rate;
+        size_t      block_size;
+    } engine_point_t;
+
+    static const engine_point_t engine_points[] =
+    {
+        { meta::filter_metadata::PEM_IIR,   0,  44100,  64      },
+        { meta::filter_metadata::PEM_IIR,   0,  192000, 4096    },
+        { meta::filter_metadata::PEM_IIR,   1,  48000,  1024    },
+        { meta::filter_metadata::PEM_IIR,   3,  48000,  1024    },
+        { meta::filter_metadata::PEM_IIR,   5,  48000,  1024    },
+        { meta::filter_metadata::PEM_IIR,   5,  96000,  256     },
+        { meta::filter_metadata::PEM_FIR,   3,  48000,  1024    },
+        { meta::filter_metadata::PEM_FIR,   0,  192000, 4096    },
+        { meta::filter_metadata::PEM_FFT,   0,  44100,  64      },
+        { meta::filter_metadata::PEM_FFT,   0,  192000, 4096    },
+        { meta::filter_metadata::PEM_SPM,   0,  96000,  256     },
+        { meta::filter_metadata::PEM_HLP,   3,  48000,  64      },
+        { meta::filter_metadata::PEM_HMP,   0,  192000, 1024    },
+    };
+
+    // Filters measured by the mono plugin in the convolution mode: the cheapest, the typical and the most expensive ones
+    typedef struct filter_point_t
+    {
+        size_t      type;
+        size_t      mode;
+        size_t      slope;
+    } filter_point_t;
+
+    static const filter_point_t filter_points[] =
+    {
+        { meta::filter_metadata::EQF_BELL,          meta::filter_metadata::EFM_RLC_BT,  0   },
+        { meta::filter_metadata::EQF_HIPASS,        meta::filter_metadata::EFM_APO_DR,  0   },
+        { meta::filter_metadata::EQF_LOSHELF,       meta::filter_metadata::EFM_LRX_MT,  3   },
+        { meta::filter_metadata::EQF_BANDPASS,      meta::filter_metadata::EFM_BWC_MT,  5   },
+        { meta::filter_metadata::EQF_LADDERPASS,    meta::filter_metadata::EFM_RLC_MT,  7   },
+        { meta::filter_metadata::EQF_LOPASS,        meta::filter_metadata::EFM_LRX_BT,  7   },
+    };
+}
+
+PTEST_BEGIN("filter", process, 1, 100)
+
+    void process_block(test::PluginHost *host, size_t samples, size_t *calls)
+    {
+        host->process(samples);
+        ++(*calls);
+    }
+
+    void bench(const bench_config_t *cfg)
+    {
+        const layout_t *layout          = cfg->layout;
+        const meta::plugin_t *meta      = layout->metadata;
+
+        test::PluginHost host;
+        status_t res = host.init(
+            new plugins::filter(meta, layout->channels, layout->filters, layout->mode),
+            cfg->sample_rate, cfg->block_size);
+        if (res != STATUS_OK)
+        {
+            printf("Failed to initialize plugin %s, error code=%d\n", meta->uid, int(res));
+            return;
+        }
+
+        // Configure the plugin, disable all visualization stuff
+        char id[32];
+        host.set("mode", cfg->eq_mode);
+        host.set("decramp", cfg->decramp);
+        for (const char * const *sfx = layout->an_ids; *sfx != NULL; ++sfx)
+        {
+            snprintf(id, sizeof(id), "ife%s", *sfx);
+            host.set(id, 0.0f);
+            snprintf(id, sizeof(id), "ofe%s", *sfx);
+            host.set(id, 0.0f);
+        }
+
+        // All filters of the layout are enabled and spread over the spectrum
+        float freq                      = 1000.0f;
+        for (const char * const *sfx = layout->ids; *sfx != NULL; ++sfx)
+        {
+            if (layout->filters > 1)
+            {
+                snprintf(id, sizeof(id), "fe%s", *sfx);
+                host.set(id, 1.0f);
+            }
+            snprintf(id, sizeof(id), "ft%s", *sfx);
+            host.set(id, cfg->type);
+            snprintf(id, sizeof(id), "fm%s", *sfx);
+            host.set(id, cfg->mode);
+            snprintf(id, sizeof(id), "s%s", *sfx);
+            host.set(id, cfg->slope);
+            snprintf(id, sizeof(id), "f%s", *sfx);
+            host.set(id, freq);
+            snprintf(id, sizeof(id), "g%s", *sfx);
+            host.set(id, GAIN_AMP_P_6_DB);
+            snprintf(id, sizeof(id), "q%s", *sfx);
+            host.set(id, 0.5f);
+            freq                           *= 2.0f;
+        }
+
+        // Fill input buffers with noise
+        for (size_t i=0; i<host.inputs(); ++i)
+        {
+            float *buf          = host.input(i);
+            for (size_t j=0; j<cfg->block_size; ++j)
+                buf[j]              = (float(rand()) / float(RAND_MAX)) * 2.0f - 1.0f;
+        }
+
+        // Warm-up: apply settings and let the kernel transitions complete
+        const size_t transition = KERNEL_SIZE_MAX * 2 +
+            dspu::millis_to_samples(cfg->sample_rate, meta::filter_metadata::SMOOTH_TIME_DFL);
+        const size_t warmup     = (transition * TRANSITIONS + cfg->block_size - 1) / cfg->block_size;
+        for (size_t i=0; i<warmup; ++i)
+            host.process(cfg->block_size);
+
+        // Measure
+        char key[128];
+        snprintf(key, sizeof(key), "%s %s type=%d mode=%d slope=%s decramp=%s sr=%ld bs=%d",
+            meta->uid,
+            eq_modes[cfg->eq_mode],
+            int(cfg->type),
+            int(cfg->mode),
+            slopes[cfg->slope],
+            decramp_modes[cfg->decramp],
+            long(cfg->sample_rate),
+            int(cfg->block_size));
+        printf("Testing %s...\n", key);
+
+        size_t calls            = 0;
+        const auto start        = std::chrono::steady_clock::now();
+        PTEST_LOOP(key, process_block(&host, cfg->block_size, &calls));
+        const auto end          = std::chrono::steady_clock::now();
+
+        // Machine-readable result to compare builds: time per sample and realtime factor
+        const double elapsed    = lsp_max(std::chrono::duration<double>(end - start).count(), 1e-9);
+        const double samples    = double(lsp_max(calls, size_t(1))) * cfg->block_size;
+        printf("BENCH;%s;%s;%d;%d;%s;%s;%ld;%d;%.3f;%.2f\n",
+            meta->uid,
+            eq_modes[cfg->eq_mode],
+            int(cfg->type),
+            int(cfg->mode),
+            slopes[cfg->slope],
+            decramp_modes[cfg->decramp],
+            long(cfg->sample_rate),
+            int(cfg->block_size),
+            elapsed * 1e+9 / samples,
+            samples / (cfg->sample_rate * elapsed));
+
+        host.destroy();
+    }
+
+    PTEST_MAIN
+    {
+        bench_config_t cfg;
+
+        printf("BENCH;plugin;eq_mode;type;mode;slope;decramp;sample_rate;block_size;ns_per_sample;realtime_factor\n");
+
+        // Each layout in each equalizer mode with the typical filter
+        cfg.type            = meta::filter_metadata::EQF_LOPASS;
+        cfg.mode            = meta::filter_metadata::EFM_BWC_BT;
+        cfg.slope           = 1;
+        cfg.decramp         = 0;
+        cfg.sample_rate     = 48000;
+        cfg.block_size      = 1024;
+        for (size_t i=0; i < sizeof(layouts)/sizeof(layouts[0]); ++i)
+        {
+            cfg.layout          = &layouts[i];
+            for (size_t eq_mode=0; eq_mode < sizeof(eq_modes)/sizeof(eq_modes[0]); ++eq_mode)
+            {
+                cfg.eq_mode         = eq_mode;
+                bench(&cfg);
+            }
+        }
+        PTEST_SEPARATOR;
+
+        // Decramping, sample rates and block sizes
+        cfg.layout          = &layouts[0];
+        for (size_t i=0; i < sizeof(engine_points)/sizeof(engine_points[0]); ++i)
+        {
+            const engine_point_t *p = &engine_points[i];
+            cfg.eq_mode         = p->eq_mode;
+            cfg.decramp         = p->decramp;
+            cfg.sample_rate     = p->sample_rate;
+            cfg.block_size      = p->block_size;
+            bench(&cfg);
+        }
+        PTEST_SEPARATOR;
+
+        // All filter types, modes and slopes in the recursive mode
+        cfg.eq_mode         = meta::filter_metadata::PEM_IIR;
+        cfg.decramp         = 0;
+        cfg.sample_rate     = 48000;
+        cfg.block_size      = 1024;
+        for (size_t type=0; type < NUM_FILTER_TYPES; ++type)
+            for (size_t mode=0; mode < NUM_FILTER_MODES; ++mode)
+                for (size_t slope=0; slope < NUM_SLOPES; ++slope)
+                {
+                    cfg.type            = type;
+                    cfg.mode            = mode;
+                    cfg.slope           = slope;
+                    bench(&cfg);
+                }
+        PTEST_SEPARATOR;
+
+        // Representative filters in the convolution mode
+        cfg.eq_mode         = meta::filter_metadata::PEM_FFT;
+        for (size_t i=0; i < sizeof(filter_points)/sizeof(filter_points[0]); ++i)
+        {
+            const filter_point_t *p = &filter_points[i];
+            cfg.type            = p->type;
+            cfg.mode            = p->mode;
+            cfg.slope           = p->slope;
+            bench(&cfg);
+        }
+    }
+
+PTEST_END
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-filter
+ * Created on: 16 окт. 2026 г.
+ *
+ * lsp-plugins-filter is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-filter is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-filter. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <private/plugins/filter.h>
+
+namespace
+{
+    using namespace lsp;
+
+    static const long sample_rates[]        = { 44100, 48000, 88200, 96000, 176400, 192000 };
+}
+
+UTEST_BEGIN("filter", fft)
+
+    void check_auto_rank()
+    {
+        // The automatic FFT size keeps the duration of the frame
+        size_t prev         = 0;
+        for (size_t i=0; i < sizeof(sample_rates)/sizeof(sample_rates[0]); ++i)
+        {
+            const long sr       = sample_rates[i];
+            const size_t rank   = plugins::filter::select_fft_rank(0, sr);
+            printf("Automatic FFT rank at sample rate %ld: %d\n", sr, int(rank));
+
+            UTEST_ASSERT_MSG(rank >= meta::filter_metadata::FFT_RANK_MIN,
+                "Rank %d is less than the minimum rank %d at sample rate %ld",
+                int(rank), int(meta::filter_metadata::FFT_RANK_MIN), sr);
+            UTEST_ASSERT_MSG(rank <= meta::filter_metadata::FFT_RANK_MAX,
+                "Rank %d is greater than the maximum rank %d at sample rate %ld",
+                int(rank), int(meta::filter_metadata::FFT_RANK_MAX), sr);
+            UTEST_ASSERT_MSG(rank >= prev,
+                "Rank %d at sample rate %ld is less than rank %d at lower sample rate",
+                int(rank), sr, int(prev));
+            prev                = rank;
+        }
+
+        const size_t r44k   = plugins::filter::select_fft_rank(0, 44100);
+        const size_t r192k  = plugins::filter::select_fft_rank(0, 192000);
+        UTEST_ASSERT_MSG(r192k > r44k,
+            "Automatic FFT rank does not depend on the sample rate: 44.1k -> %d, 192k -> %d",
+            int(r44k), int(r192k));
+    }
+
+    void check_fixed_rank()
+    {
+        // The explicitly selected FFT size does not depend on the sample rate
+        for (size_t res=1; res <= meta::filter_metadata::FFT_RANK_MAX - meta::filter_metadata::FFT_RANK_MIN + 1; ++res)
+        {
+            const size_t expected   = meta::filter_metadata::FFT_RANK_MIN + res - 1;
+            for (size_t i=0; i < sizeof(sample_rates)/sizeof(sample_rates[0]); ++i)
+            {
+                const long sr           = sample_rates[i];
+                const size_t rank       = plugins::filter::select_fft_rank(res, sr);
+                UTEST_ASSERT_MSG(rank == expected,
+                    "Resolution %d at sample rate %ld gives rank %d, expected %d",
+                    int(res), sr, int(rank), int(expected));
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        printf("Testing automatic FFT rank selection...\n");
+        check_auto_rank();
+        printf("Testing fixed FFT rank selection...\n");
+        check_fixed_rank();
+    }
+
+UTEST_END
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-filter
+ * Created on: 16 окт. 2026 г.
+ *
+ * lsp-plugins-filter is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-filter is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-filter. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <private/plugins/filter.h>
+
+#include "../helpers/plugin_host.h"
+
+namespace
+{
+    using namespace lsp;
+
+    static constexpr long SAMPLE_RATE       = 48000;
+    static constexpr size_t BLOCK_SIZE      = 1024;
+    static constexpr size_t WARMUP_BLOCKS   = 64;
+    static constexpr size_t CAPTURE_SIZE    = 0x10000;
+
+    // Capture buffer which is released on any exit from the test case
+    typedef struct capture_t
+    {
+        float      *data;
+
+        explicit capture_t(size_t size)     { data = new float[size]; }
+        ~capture_t()                        { delete [] data; }
+    } capture_t;
+
+    static const char *eq_modes[]           = { "IIR", "FIR", "FFT", "SPM", "HLP", "HMP" };
+    static const char *decramp_modes[]      = { "x1", "x2", "x3", "x4", "x6", "x8" };
+
+    typedef struct latency_config_t
+    {
+        size_t      eq_mode;
+        size_t      decramp;
+        size_t      quality;
+        float       gain;
+    } latency_config_t;
+}
+
+UTEST_BEGIN("filter", latency)
+
+    size_t resampler_qualities()
+    {
+        // The number of resampler kernels is defined by the items of the port
+        for (const meta::port_t *p = meta::filter_mono.ports; p->id != NULL; ++p)
+        {
+            if (strcmp(p->id, "rsq") != 0)
+                continue;
+
+            size_t count        = 0;
+            for (const meta::port_item_t *item = p->items; (item != NULL) && (item->text != NULL); ++item)
+                ++count;
+            return count;
+        }
+
+        return 0;
+    }
+
+    void check_latency(const latency_config_t *cfg)
+    {
+        printf("Testing mode=%s, decramp=%s, quality=%d, gain=%.2f\n",
+            eq_modes[cfg->eq_mode], decramp_modes[cfg->decramp], int(cfg->quality), cfg->gain);
+
+        test::PluginHost host;
+        status_t res = host.init(
+            new plugins::filter(&meta::filter_mono, 1, 1, plugins::filter::EQ_MONO),
+            SAMPLE_RATE, BLOCK_SIZE);
+        UTEST_ASSERT(res == STATUS_OK);
+
+        host.set("mode", cfg->eq_mode);
+        host.set("decramp", cfg->decramp);
+        host.set("rsq", cfg->quality);
+        host.set("ft", meta::filter_metadata::EQF_BELL);
+        host.set("fm", meta::filter_metadata::EFM_RLC_BT);
+        host.set("f", 1000.0f);
+        host.set("g", cfg->gain);
+        host.set("q", 0.5f);
+        host.set("ife", 0.0f);
+        host.set("ofe", 0.0f);
+
+        // Let the kernel design and the parameter transitions complete
+        float *in           = host.input(0);
+        float *out          = host.output(0);
+        dsp::fill_zero(in, BLOCK_SIZE);
+        for (size_t i=0; i<WARMUP_BLOCKS; ++i)
+            host.process(BLOCK_SIZE);
+
+        // Send the impulse and capture the response
+        capture_t buf(CAPTURE_SIZE);
+        float *capture      = buf.data;
+        UTEST_ASSERT(capture != NULL);
+        in[0]               = 1.0f;
+        for (size_t offset=0; offset < CAPTURE_SIZE; offset += BLOCK_SIZE)
+        {
+            host.process(BLOCK_SIZE);
+            dsp::copy(&capture[offset], out, BLOCK_SIZE);
+            in[0]               = 0.0f;
+        }
+
+        // The direct component of the bell filter dominates the impulse response, so its peak
+        // should be located at the reported latency
+        const ssize_t latency   = host.module()->latency();
+        const ssize_t peak      = dsp::abs_max_index(capture, CAPTURE_SIZE);
+        UTEST_ASSERT_MSG(fabsf(capture[peak]) > 0.5f,
+            "No impulse response, peak=%f", capture[peak]);
+        UTEST_ASSERT_MSG(lsp_abs(peak - latency) <= 1,
+            "Impulse delay %d does not match reported latency %d", int(peak), int(latency));
+
+        // The latency meters should match the reported latency
+        const float lat_ms      = dspu::samples_to_millis(SAMPLE_RATE, latency);
+        UTEST_ASSERT_MSG(fabsf(host.get("lat") - lat_ms) <= 0.01f,
+            "Latency meter %f does not match reported latency %f ms", host.get("lat"), lat_ms);
+        UTEST_ASSERT_MSG(fabsf(host.get("lat_ovs") + host.get("lat_eq") - lat_ms) <= 0.01f,
+            "Latency breakdown %f + %f does not sum to %f ms", host.get("lat_ovs"), host.get("lat_eq"), lat_ms);
+
+        host.destroy();
+    }
+
+    UTEST_MAIN
+    {
+        latency_config_t cfg;
+        cfg.quality         = meta::filter_metadata::RESAMPLER_DFL;
+
+        // Active filter in all modes, the transparent filter would bypass the equalizer
+        cfg.gain            = GAIN_AMP_P_6_DB;
+        for (size_t eq_mode=0; eq_mode < sizeof(eq_modes)/sizeof(eq_modes[0]); ++eq_mode)
+            for (size_t decramp=0; decramp < sizeof(decramp_modes)/sizeof(decramp_modes[0]); ++decramp)
+            {
+                cfg.eq_mode         = eq_mode;
+                cfg.decramp         = decramp;
+                check_latency(&cfg);
+            }
+
+        // Cut in all modes
+        cfg.gain            = GAIN_AMP_M_6_DB;
+        cfg.decramp         = 0;
+        for (size_t eq_mode=0; eq_mode < sizeof(eq_modes)/sizeof(eq_modes[0]); ++eq_mode)
+        {
+            cfg.eq_mode         = eq_mode;
+            check_latency(&cfg);
+        }
+
+        // All resampler kernels
+        cfg.eq_mode         = meta::filter_metadata::PEM_FIR;
+        cfg.decramp         = 1;
+        const size_t qualities  = resampler_qualities();
+        UTEST_ASSERT(qualities > 0);
+        for (size_t quality=0; quality < qualities; ++quality)
+        {
+            cfg.quality         = quality;
+            check_latency(&cfg);
+        }
+    }
+
+UTEST_END
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-filter
+ * Created on: 16 окт. 2026 г.
+ *
+ * lsp-plugins-filter is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-filter is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-filter. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+
+#include <private/plugins/filter.h>
+
+#include "../helpers/plugin_host.h"
+
+namespace
+{
+    using namespace lsp;
+
+    static constexpr long SAMPLE_RATE       = 48000;
+    static constexpr size_t BLOCK_SIZE      = 512;
+    static constexpr size_t NUM_BLOCKS      = 16;
+
+    static const float smooth_times[]       = { 0.0f, 1.0f, 10.0f };
+}
+
+UTEST_BEGIN("filter", link)
+
+    void process_noise(test::PluginHost *host, size_t blocks)
+    {
+        float *in_l         = host->input(0);
+        float *in_r         = host->input(1);
+
+        for (size_t i=0; i<blocks; ++i)
+        {
+            // Both channels receive the same signal
+            for (size_t j=0; j<BLOCK_SIZE; ++j)
+                in_l[j]             = (float(rand()) / float(RAND_MAX)) * 2.0f - 1.0f;
+            dsp::copy(in_r, in_l, BLOCK_SIZE);
+
+            host->process(BLOCK_SIZE);
+
+            const float *out_l  = host->output(0);
+            const float *out_r  = host->output(1);
+            for (size_t j=0; j<BLOCK_SIZE; ++j)
+            {
+                UTEST_ASSERT_MSG(fabsf(out_l[j] - out_r[j]) <= 1e-5f,
+                    "Outputs differ at block %d, sample %d: left=%f, right=%f",
+                    int(i), int(j), out_l[j], out_r[j]);
+            }
+        }
+    }
+
+    void check_link(float smooth)
+    {
+        printf("Testing linked channels, smoothing=%.1f ms\n", smooth);
+
+        test::PluginHost host;
+        status_t res = host.init(
+            new plugins::filter(&meta::filter_stereo, 2, 1, plugins::filter::EQ_STEREO),
+            SAMPLE_RATE, BLOCK_SIZE);
+        UTEST_ASSERT(res == STATUS_OK);
+
+        host.set("mode", meta::filter_metadata::PEM_IIR);
+        host.set("smooth", smooth);
+        host.set("ft", meta::filter_metadata::EQF_BELL);
+        host.set("f", 1000.0f);
+        host.set("g", GAIN_AMP_P_6_DB);
+        host.set("q", 0.5f);
+        host.set("ife_l", 0.0f);
+        host.set("ofe_l", 0.0f);
+        host.set("ife_r", 0.0f);
+        host.set("ofe_r", 0.0f);
+        process_noise(&host, NUM_BLOCKS);
+
+        // Change parameters that can be smoothed, both channels should follow
+        host.set("f", 3000.0f);
+        host.set("g", GAIN_AMP_M_6_DB);
+        process_noise(&host, NUM_BLOCKS);
+
+        host.set("q", 2.0f);
+        process_noise(&host, NUM_BLOCKS);
+
+        host.destroy();
+    }
+
+    UTEST_MAIN
+    {
+        for (size_t i=0; i < sizeof(smooth_times)/sizeof(smooth_times[0]); ++i)
+            check_link(smooth_times[i]);
+    }
+
+UTEST_END
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-filter
+ * Created on: 16 окт. 2026 г.
+ *
+ * lsp-plugins-filter is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-filter is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-filter. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+
+#include <private/plugins/filter.h>
+
+#include <chrono>
+
+#include "../helpers/plugin_host.h"
+
+namespace
+{
+    using namespace lsp;
+
+    static constexpr long SAMPLE_RATE       = 48000;
+    static constexpr size_t BLOCK_SIZE      = 256;
+    static constexpr size_t WARMUP_BLOCKS   = 512;
+    static constexpr size_t MEASURE_BLOCKS  = 64;
+    static constexpr size_t BYPASS_BLOCKS   = 64;
+    static constexpr size_t RELEASES        = 8;
+
+    // The pre-roll replays a few blocks of 1024 samples, the replay of the whole kernel
+    // of the hybrid mode would take more than a hundred blocks of the test
+    static constexpr float MAX_LOAD_RATIO   = 48.0f;
+
+    static const size_t eq_modes[]          =
+    {
+        meta::filter_metadata::PEM_IIR,
+        meta::filter_metadata::PEM_FFT,
+        meta::filter_metadata::PEM_HLP,
+        meta::filter_metadata::PEM_HMP
+    };
+}
+
+UTEST_BEGIN("filter", preroll)
+
+    uint64_t process_block(test::PluginHost *host)
+    {
+        float *in           = host->input(0);
+        for (size_t i=0; i<BLOCK_SIZE; ++i)
+            in[i]               = (float(rand()) / float(RAND_MAX)) * 2.0f - 1.0f;
+
+        const auto start    = std::chrono::steady_clock::now();
+        host->process(BLOCK_SIZE);
+        const auto end      = std::chrono::steady_clock::now();
+
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    void check_release(size_t eq_mode)
+    {
+        printf("Testing bypass release in mode %d\n", int(eq_mode));
+
+        test::PluginHost host;
+        status_t res = host.init(
+            new plugins::filter(&meta::filter_mono, 1, 1, plugins::filter::EQ_MONO),
+            SAMPLE_RATE, BLOCK_SIZE);
+        UTEST_ASSERT(res == STATUS_OK);
+
+        // The steep low-frequency filter selects the longest kernel
+        host.set("mode", eq_mode);
+        host.set("ft", meta::filter_metadata::EQF_HIPASS);
+        host.set("s", 7);
+        host.set("f", 20.0f);
+        host.set("ife", 0.0f);
+        host.set("ofe", 0.0f);
+
+        for (size_t i=0; i<WARMUP_BLOCKS; ++i)
+            process_block(&host);
+
+        // The median load of the regular block
+        uint64_t times[MEASURE_BLOCKS];
+        for (size_t i=0; i<MEASURE_BLOCKS; ++i)
+            times[i]            = process_block(&host);
+        for (size_t i=1; i<MEASURE_BLOCKS; ++i)
+            for (size_t j=i; (j > 0) && (times[j-1] > times[j]); --j)
+                lsp::swap(times[j-1], times[j]);
+        const uint64_t regular  = lsp_max(times[MEASURE_BLOCKS / 2], uint64_t(1));
+
+        // The lowest load of the release block is not affected by the scheduling of the test
+        uint64_t release    = UINT64_MAX;
+        for (size_t i=0; i<RELEASES; ++i)
+        {
+            host.set("enabled", 1.0f);
+            for (size_t j=0; j<BYPASS_BLOCKS; ++j)
+                process_block(&host);
+
+            host.set("enabled", 0.0f);
+            release             = lsp_min(release, process_block(&host));
+
+            for (size_t j=0; j<BYPASS_BLOCKS; ++j)
+                process_block(&host);
+        }
+
+        const float ratio   = float(release) / float(regular);
+        printf("  regular block: %.1f us, release block: %.1f us, ratio: %.1f\n",
+            regular * 1e-3f, release * 1e-3f, ratio);
+        UTEST_ASSERT_MSG(ratio <= MAX_LOAD_RATIO,
+            "The release block in mode %d is %.1f times longer than the regular one",
+            int(eq_mode), ratio);
+
+        host.destroy();
+    }
+
+    UTEST_MAIN
+    {
+        for (size_t i=0; i<sizeof(eq_modes)/sizeof(eq_modes[0]); ++i)
+            check_release(eq_modes[i]);
+    }
+
+UTEST_END
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-filter
+ * Created on: 16 окт. 2026 г.
+ *
+ * lsp-plugins-filter is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-filter is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-filter. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#include <private/plugins/filter.h>
+
+#include "../helpers/plugin_host.h"
+
+namespace
+{
+    using namespace lsp;
+
+    static constexpr long SAMPLE_RATE       = 48000;
+    static constexpr size_t BLOCK_SIZE      = 256;
+    static constexpr size_t WARMUP_BLOCKS   = 512;
+    static constexpr size_t CHECK_BLOCKS    = 512;
+    static constexpr float  SINE_FREQ       = 440.0f;
+    static constexpr float  SINE_AMP        = 0.5f;
+
+    // The bell filter does not attenuate the sine, so the block with lower peak is muted.
+    // The sine at the output of the filter changes by less than 0.06 per sample, the larger
+    // step is a click
+    static constexpr float  MIN_PEAK        = 0.05f;
+    static constexpr float  MAX_STEP        = 0.15f;
+
+    typedef struct transition_t
+    {
+        const char     *name;
+        size_t          mode;           // Initial equalizer mode
+        size_t          decramp;        // Decramping
+        float           bypass;         // Initial state of the bypass
+        float           freq;           // Initial frequency of the filter
+        const char     *port;           // The port to change
+        float           value;          // The new value of the port
+        bool            fixed;          // The reported latency should not change
+    } transition_t;
+
+    static const transition_t transitions[] =
+    {
+        // Switching modes
+        { "IIR to HMP",             meta::filter_metadata::PEM_IIR, 0, 0.0f, 1000.0f,   "mode", meta::filter_metadata::PEM_HMP, true    },
+        { "HMP to IIR",             meta::filter_metadata::PEM_HMP, 0, 0.0f, 1000.0f,   "mode", meta::filter_metadata::PEM_IIR, true    },
+        { "IIR to FIR",             meta::filter_metadata::PEM_IIR, 0, 0.0f, 1000.0f,   "mode", meta::filter_metadata::PEM_FIR, false   },
+        { "FIR to FFT",             meta::filter_metadata::PEM_FIR, 0, 0.0f, 1000.0f,   "mode", meta::filter_metadata::PEM_FFT, false   },
+        { "FFT to SPM",             meta::filter_metadata::PEM_FFT, 0, 0.0f, 1000.0f,   "mode", meta::filter_metadata::PEM_SPM, false   },
+        { "SPM to HLP",             meta::filter_metadata::PEM_SPM, 0, 0.0f, 1000.0f,   "mode", meta::filter_metadata::PEM_HLP, false   },
+        { "HLP to HMP",             meta::filter_metadata::PEM_HLP, 0, 0.0f, 1000.0f,   "mode", meta::filter_metadata::PEM_HMP, false   },
+        { "HMP to FIR",             meta::filter_metadata::PEM_HMP, 0, 0.0f, 1000.0f,   "mode", meta::filter_metadata::PEM_FIR, false   },
+        { "HLP to IIR",             meta::filter_metadata::PEM_HLP, 0, 0.0f, 1000.0f,   "mode", meta::filter_metadata::PEM_IIR, false   },
+
+        // Releasing bypass
+        { "bypass release in IIR",  meta::filter_metadata::PEM_IIR, 0, 1.0f, 1000.0f,   "enabled", 0.0f,                        true    },
+        { "bypass release in FIR",  meta::filter_metadata::PEM_FIR, 0, 1.0f, 1000.0f,   "enabled", 0.0f,                        true    },
+        { "bypass release in HLP",  meta::filter_metadata::PEM_HLP, 0, 1.0f, 1000.0f,   "enabled", 0.0f,                        true    },
+        { "bypass release in HMP",  meta::filter_metadata::PEM_HMP, 0, 1.0f, 1000.0f,   "enabled", 0.0f,                        true    },
+
+        // Changing the rank of the kernel
+        { "rank in FIR",            meta::filter_metadata::PEM_FIR, 0, 0.0f, 1000.0f,   "f", 30.0f,                             false   },
+        { "rank in HLP",            meta::filter_metadata::PEM_HLP, 0, 0.0f, 1000.0f,   "f", 30.0f,                             false   },
+        { "rank in HMP",            meta::filter_metadata::PEM_HMP, 0, 0.0f, 1000.0f,   "f", 30.0f,                             true    },
+        { "rank in HMP back",       meta::filter_metadata::PEM_HMP, 0, 0.0f, 30.0f,     "f", 1000.0f,                           true    },
+
+        // Automatic decramping switches the oversampling
+        { "automatic decramping",   meta::filter_metadata::PEM_IIR, 6, 0.0f, 1000.0f,   "f", 16000.0f,                          true    },
+
+        { NULL, 0, 0, 0.0f, 0.0f, NULL, 0.0f, false }
+    };
+}
+
+UTEST_BEGIN("filter", transition)
+
+    void process_sine(test::PluginHost *host, size_t *phase)
+    {
+        float *in           = host->input(0);
+        const float k       = 2.0f * M_PI * SINE_FREQ / SAMPLE_RATE;
+        for (size_t i=0; i<BLOCK_SIZE; ++i)
+            in[i]               = SINE_AMP * sinf(k * float((*phase + i) % SAMPLE_RATE));
+        *phase             += BLOCK_SIZE;
+
+        host->process(BLOCK_SIZE);
+    }
+
+    void check_transition(const transition_t *t)
+    {
+        printf("Testing transition: %s\n", t->name);
+
+        // Background tasks are run in place, so the transition does not depend on scheduling
+        test::PluginHost host;
+        status_t res = host.init(
+            new plugins::filter(&meta::filter_mono, 1, 1, plugins::filter::EQ_MONO),
+            SAMPLE_RATE, BLOCK_SIZE, true);
+        UTEST_ASSERT(res == STATUS_OK);
+
+        host.set("mode", t->mode);
+        host.set("decramp", t->decramp);
+        host.set("enabled", t->bypass);
+        host.set("ft", meta::filter_metadata::EQF_BELL);
+        host.set("fm", meta::filter_metadata::EFM_RLC_BT);
+        host.set("f", t->freq);
+        host.set("g", GAIN_AMP_P_6_DB);
+        host.set("q", 0.5f);
+        host.set("ife", 0.0f);
+        host.set("ofe", 0.0f);
+
+        size_t phase        = 0;
+        for (size_t i=0; i<WARMUP_BLOCKS; ++i)
+            process_sine(&host, &phase);
+
+        // Change the setting and check the output until the transition is over
+        const float *out    = host.output(0);
+        float prev          = out[BLOCK_SIZE - 1];
+        ssize_t latency     = host.module()->latency();
+        UTEST_ASSERT(host.set(t->port, t->value));
+
+        for (size_t i=0; i<CHECK_BLOCKS; ++i)
+        {
+            process_sine(&host, &phase);
+
+            // The change of the reported latency shifts the signal
+            const ssize_t next_latency  = host.module()->latency();
+            UTEST_ASSERT_MSG((!t->fixed) || (next_latency == latency),
+                "Latency changed from %d to %d at block %d", int(latency), int(next_latency), int(i));
+            const bool shifted  = next_latency != latency;
+            latency             = next_latency;
+
+            float peak          = 0.0f;
+            for (size_t j=0; j<BLOCK_SIZE; ++j)
+            {
+                const float s       = out[j];
+                UTEST_ASSERT_MSG((!isnan(s)) && (!isinf(s)),
+                    "Invalid sample at block %d, sample %d: %f", int(i), int(j), s);
+                UTEST_ASSERT_MSG((shifted) || (fabsf(s - prev) <= MAX_STEP),
+                    "Discontinuity at block %d, sample %d: %f -> %f", int(i), int(j), prev, s);
+                peak                = lsp_max(peak, fabsf(s));
+                prev                = s;
+            }
+
+            UTEST_ASSERT_MSG(peak >= MIN_PEAK,
+                "Muted output at block %d, peak=%f", int(i), peak);
+        }
+
+        host.destroy();
+    }
+
+    UTEST_MAIN
+    {
+        for (const transition_t *t = transitions; t->name != NULL; ++t)
+            check_transition(t);
+    }
+
+UTEST_END